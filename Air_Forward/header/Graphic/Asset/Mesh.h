@@ -48,6 +48,7 @@ namespace Graphic
 				virtual ~MeshInstance();
 			private:
 				void _LoadAssetInstance(Graphic::Command::CommandBuffer* const transferCommandBuffer)override;
+				size_t _ResidentSize()override;
 			};
 
 		public:
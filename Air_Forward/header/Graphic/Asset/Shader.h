@@ -20,6 +20,9 @@ namespace Graphic
 		enum class SlotType
 		{
 			UNIFORM_BUFFER,
+			STORAGE_BUFFER,
+			UNIFORM_BUFFER_DYNAMIC,
+			STORAGE_BUFFER_DYNAMIC,
 			TEXTURE2D,
 			TEXTURE2D_WITH_INFO,
 			TEXTURE_CUBE
@@ -28,6 +31,8 @@ namespace Graphic
 		{
 			friend class IO::Asset::IAsset;
 		public:
+			//Buffers in this set are bound from per frame ring buffers with dynamic offsets
+			static const uint32_t FRAME_DATA_SET = 0;
 			struct SlotLayout
 			{
 				std::string slotName;
@@ -103,7 +108,9 @@ namespace Graphic
 				std::map<std::string, SlotLayout> _slotLayouts;
 				VkPipeline _vkPipeline;
 				VkPipelineLayout _vkPipelineLayout;
+				size_t _spirvSize;
 				void _LoadAssetInstance(Graphic::Command::CommandBuffer* const transferCommandBuffer)override;
+				size_t _ResidentSize()override;
 				
 				void _ParseShaderData(_PipelineData& pipelineData);
 				void _LoadSpirvs(_PipelineData& pipelineData);
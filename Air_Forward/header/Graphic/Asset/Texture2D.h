@@ -94,6 +94,7 @@ namespace Graphic
 				Texture2DSetting _settings;
 
 				void _LoadAssetInstance(Graphic::Command::CommandBuffer* const transferCommandBuffer)override;
+				size_t _ResidentSize()override;
 			};
 
 		public:
@@ -67,6 +67,7 @@ namespace Graphic
 				TextureCubeSetting _settings;
 
 				void _LoadAssetInstance(Graphic::Command::CommandBuffer* const transferCommandBuffer)override;
+				size_t _ResidentSize()override;
 			};
 
 		public:
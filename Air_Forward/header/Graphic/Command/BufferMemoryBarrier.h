@@ -0,0 +1,22 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+#include <vector>
+namespace Graphic
+{
+	namespace Instance
+	{
+		class Buffer;
+	}
+	namespace Command
+	{
+		class BufferMemoryBarrier
+		{
+			std::vector<VkBufferMemoryBarrier> _vkBufferMemoryBarriers;
+		public:
+			BufferMemoryBarrier(Instance::Buffer* buffer, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags);
+			BufferMemoryBarrier(Instance::Buffer* buffer, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex);
+			~BufferMemoryBarrier();
+			const std::vector<VkBufferMemoryBarrier>& VkBufferMemoryBarriers();
+		};
+	}
+}
\ No newline at end of file
@@ -27,20 +27,38 @@ namespace Graphic
 	{
 		class Semaphore;
 		class ImageMemoryBarrier;
+		class BufferMemoryBarrier;
 		class CommandPool;
 		class CommandBuffer
 		{
 			friend class CommandPool;
+		public:
+			struct BindStatistics
+			{
+				uint32_t pipelineBindCount;
+				uint32_t pipelineSkipCount;
+				uint32_t meshBindCount;
+				uint32_t meshSkipCount;
+				uint32_t descriptorSetBindCount;
+				uint32_t descriptorSetSkipCount;
+			};
 		private:
 			struct _CommandData
 			{
 				uint32_t indexCount;
+				VkPipeline pipeline;
+				VkBuffer vertexBuffer;
+				VkBuffer indexBuffer;
+				VkPipelineLayout pipelineLayout;
+				std::vector<VkDescriptorSet> descriptorSets;
+				std::vector<uint32_t> dynamicOffsets;
 			};
 			CommandPool* const _parentCommandPool;
 			VkCommandBuffer _vkCommandBuffer;
 			VkFence _vkFence;
 
 			_CommandData _commandData;
+			BindStatistics _bindStatistics;
 		public:
 			std::string const _name;
 
@@ -55,22 +73,32 @@ namespace Graphic
 		public:
 			void Reset();
 			void BeginRecord(VkCommandBufferUsageFlags flag);
+			void BeginRecord(VkCommandBufferUsageFlags flag, Graphic::RenderPass::RenderPassHandle renderPass, uint32_t subpassIndex, Instance::FrameBufferHandle frameBuffer);
 			void AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, std::vector <ImageMemoryBarrier*> imageMemoryBarriers);
 			void AddPipelineBarrier(VkDependencyFlags dependencyFlag, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, std::vector<ImageMemoryBarrier*> imageMemoryBarriers);
 			void AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask);
+			void AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask);
+			void AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, std::vector<ImageMemoryBarrier*> imageMemoryBarriers, std::vector<BufferMemoryBarrier*> bufferMemoryBarriers);
 			void CopyBufferToImage(Instance::Buffer* srcBuffer, Instance::Image* dstImage, VkImageLayout dstImageLayout);
+			void CopyBufferToImage(Instance::Buffer* srcBuffer, VkDeviceSize srcOffset, Instance::Image* dstImage, VkImageLayout dstImageLayout);
+			void CopyImageToBuffer(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Buffer* dstBuffer);
 			void CopyBuffer(Instance::Buffer* srcBuffer, Instance::Buffer* dstBuffer);
 			void CopyBuffer(Instance::Buffer* srcBuffer, VkDeviceSize srcOffset, Instance::Buffer* dstBuffer, VkDeviceSize dstOffset, VkDeviceSize size);
 			void EndRecord();
 			void Submit(std::vector<Command::Semaphore*> waitSemaphores, std::vector<VkPipelineStageFlags> waitStages, std::vector<Command::Semaphore*> signalSemaphores);
 			void WaitForFinish();
+			//Polls the fence of the last submission without blocking
+			bool Finished();
 			void BeginRenderPass(Graphic::RenderPass::RenderPassHandle renderPass, Instance::FrameBufferHandle frameBuffer, std::vector<VkClearValue> clearValues);
+			void BeginRenderPass(Graphic::RenderPass::RenderPassHandle renderPass, Instance::FrameBufferHandle frameBuffer, std::vector<VkClearValue> clearValues, VkSubpassContents subpassContents);
+			void ExecuteCommands(std::vector<CommandBuffer*> commandBuffers);
 			void EndRenderPass();
 			void BindShader(Asset::Shader* shader);
 			void BindMesh(Asset::Mesh* mesh);
 			void BindMaterial(Material* material);
 			void CopyImage(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Image* dstImage, VkImageLayout dstImageLayout);
-			void Draw();
+			void Draw(uint32_t instanceCount, uint32_t firstInstance);
+			const BindStatistics& Statistics();
 			void Blit(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::SwapchainImage* dstImage, VkImageLayout dstImageLayout);
 			void Blit(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Image* dstImage, VkImageLayout dstImageLayout);
 			void Blit(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Image* dstImage, VkImageLayout dstImageLayout, VkFilter filter);
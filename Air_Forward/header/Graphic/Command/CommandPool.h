@@ -25,6 +25,7 @@ namespace Graphic
 			CommandPool& operator=(CommandPool&&) = delete;
 
 			VkCommandPool VkCommandPool_();
+			const std::string& QueueName();
 
 
 			CommandBuffer* CreateCommandBuffer(std::string name, VkCommandBufferLevel level);
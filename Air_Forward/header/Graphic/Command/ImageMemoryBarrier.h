@@ -15,6 +15,8 @@ namespace Graphic
 			std::vector<VkImageMemoryBarrier> _vkImageMemoryBarriers;
 		public:
 			ImageMemoryBarrier(Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags);;
+			//Queue family ownership transfer, recorded once as release on the source queue and once as acquire on the destination queue
+			ImageMemoryBarrier(Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex);
 			ImageMemoryBarrier(Instance::SwapchainImage* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags);;
 			~ImageMemoryBarrier();
 			const std::vector<VkImageMemoryBarrier>& VkImageMemoryBarriers();
@@ -62,10 +62,12 @@ namespace Graphic
 					std::string name;
 					VkQueueFlags flag;
 					float prioritie;
-					DesiredQueue(std::string name, VkQueueFlags flag, float prioritie)
+					std::string fallbackName;
+					DesiredQueue(std::string name, VkQueueFlags flag, float prioritie, std::string fallbackName)
 						: name(name)
 						, flag(flag)
 						, prioritie(prioritie)
+						, fallbackName(fallbackName)
 					{
 
 					}
@@ -76,6 +78,7 @@ namespace Graphic
 				};
 				VkPhysicalDeviceFeatures _desiredPhysicalDeviceFeatures;
 				std::vector<std::string> _desiredDeviceExtensions;
+				std::vector<std::string> _optionalDeviceExtensions;
 				std::vector<DesiredQueue> _desiredQueues;
 #ifdef _USE_GRAPHIC_DEBUG
 				std::vector<std::string> _desiredDeviceLayers;
@@ -87,11 +90,15 @@ namespace Graphic
 				DeviceCreator();
 				~DeviceCreator();
 				void AddExtension(std::string extensionName);
+				//Enabled only when the chosen device supports it
+				void AddOptionalExtension(std::string extensionName);
 				void SetFeature(std::function<void(VkPhysicalDeviceFeatures&)> const& func);
 #ifdef _USE_GRAPHIC_DEBUG
 				void AddLayer(std::string layerName);
 #endif
 				void AddQueue(std::string name, VkQueueFlags flag, float prioritie);
+				//Shares the fallback queue when no free queue slot is left for it
+				void AddQueue(std::string name, VkQueueFlags flag, float prioritie, std::string fallbackQueueName);
 			};
 
 			static void Create(Graphic::Core::Device::DeviceCreator& creator);
@@ -99,6 +106,7 @@ namespace Graphic
 			static inline VkPhysicalDevice VkPhysicalDevice_();
 			static inline VkDevice VkDevice_();
 			static inline Graphic::Core::Device::Queue& Queue_(std::string name);
+			static bool ExtensionEnabled(std::string extensionName);
 			static inline Graphic::Manager::MemoryManager& MemoryManager();
 			static inline Graphic::Manager::RenderPassManager& RenderPassManager();
 			static inline Graphic::Manager::DescriptorSetManager& DescriptorSetManager();
@@ -107,6 +115,7 @@ namespace Graphic
 			static VkPhysicalDevice _vkPhysicalDevice;
 			static VkDevice _vkDevice;
 			static std::map<std::string, Queue*> _queues;
+			static std::vector<std::string> _enabledExtensions;
 
 			static Graphic::Manager::MemoryManager* _memoryManager;
 			static Graphic::Manager::RenderPassManager* _renderPassManager;
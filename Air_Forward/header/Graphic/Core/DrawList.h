@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Graphic/Core/FrameSnapshot.h"
+#include "Utils/RadixSort.h"
+
+namespace Graphic
+{
+	namespace Manager
+	{
+		class MatrixDataManager;
+	}
+	namespace Core
+	{
+		class DrawList final
+		{
+		public:
+			enum class SortMode
+			{
+				DEPTH_MAJOR,
+				STATE_MAJOR
+			};
+			struct DrawBatch
+			{
+				FrameSnapshot::RendererProxy* rendererProxy;
+				uint32_t firstInstance;
+				uint32_t instanceCount;
+			};
+			static const uint32_t PASS_KEY_BITS = 4;
+			static const uint32_t DEPTH_KEY_BITS = 24;
+			static const uint32_t STATE_KEY_BITS = 36;
+		private:
+			uint64_t _passKey;
+			SortMode _sortMode;
+			std::vector<uint64_t> _sortKeys;
+			std::vector<uint32_t> _indexes;
+			std::vector<FrameSnapshot::RendererProxy*> _rendererProxies;
+			std::vector<DrawBatch> _drawBatches;
+			Utils::RadixSort _radixSort;
+
+			static uint64_t _DepthKey(float viewDepth);
+			DrawList(const DrawList&) = delete;
+			DrawList& operator=(const DrawList&) = delete;
+			DrawList(DrawList&&) = delete;
+			DrawList& operator=(DrawList&&) = delete;
+		public:
+			DrawList(uint32_t passIndex, SortMode sortMode);
+			~DrawList();
+
+			//Only reads the list's settings, so culling workers can build keys concurrently
+			uint64_t SortKey(const FrameSnapshot::RendererProxy* rendererProxy, float viewDepth) const;
+			void Add(FrameSnapshot::RendererProxy* rendererProxy, uint64_t sortKey);
+			void Build(Manager::MatrixDataManager& matrixDataManager);
+			void Clear();
+			size_t Size();
+			size_t BatchCount();
+			const DrawBatch& Batch(size_t index);
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+#include <vector>
+#include <array>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include "Logic/Component/Light/Light.h"
+#include "Logic/Component/Camera/Camera.h"
+#include "Utils/IntersectionChecker.h"
+
+namespace Logic
+{
+	namespace Component
+	{
+		class Component;
+		namespace Renderer
+		{
+			class Renderer;
+		}
+	}
+}
+namespace Graphic
+{
+	class Material;
+	namespace Instance
+	{
+		class Buffer;
+	}
+	namespace Asset
+	{
+		class TextureCube;
+		class Mesh;
+	}
+	namespace Core
+	{
+		class FrameSnapshot final
+		{
+		public:
+			struct LightSnapshot
+			{
+				Logic::Component::Light::Light::LightType lightType;
+				Logic::Component::Light::Light::LightData lightData;
+				Asset::TextureCube* textureCube;
+			};
+			struct CameraSnapshot
+			{
+				Logic::Component::Camera::Camera* camera;
+				glm::mat4 viewMatrix;
+				glm::mat4 projectionMatrix;
+				std::array<glm::vec4, 6> worldClipPlanes;
+				Logic::Component::Camera::Camera::CameraData cameraData;
+			};
+			struct RendererProxy
+			{
+				glm::mat4 modelMatrix;
+				glm::vec3 boundsMin;
+				glm::vec3 boundsMax;
+				uint64_t sortKey;
+				Asset::Mesh* mesh;
+				Material* material;
+				bool enableFrustumCulling;
+			};
+
+			std::vector<LightSnapshot> lights;
+			std::vector<CameraSnapshot> cameras;
+			std::vector<RendererProxy> renderers;
+			//World bounds of renderers in the same order, laid out for batch culling
+			Utils::IntersectionChecker::BoundsArray rendererBounds;
+
+			void AddLight(std::vector<Logic::Component::Component*>& lightComponents);
+			void AddCamera(std::vector<Logic::Component::Component*>& cameraComponents);
+			void AddRenderer(std::vector<Logic::Component::Component*>& rendererComponents);
+			void Clear();
+
+			FrameSnapshot();
+			~FrameSnapshot();
+		private:
+			static uint64_t _StateKey(Asset::Mesh* mesh, Material* material);
+			FrameSnapshot(const FrameSnapshot&) = delete;
+			FrameSnapshot& operator=(const FrameSnapshot&) = delete;
+			FrameSnapshot(FrameSnapshot&&) = delete;
+			FrameSnapshot& operator=(FrameSnapshot&&) = delete;
+		};
+	}
+}
\ No newline at end of file
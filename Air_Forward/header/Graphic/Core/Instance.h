@@ -2,7 +2,8 @@
 #include <vulkan/vulkan_core.h>
 #include <vector>
 #include <string>
-#include <Utils/Condition.h>
+#include <mutex>
+#include <condition_variable>
 #include <Logic/Component/Component.h>
 namespace Logic
 {
@@ -21,17 +22,25 @@ namespace Graphic
 	namespace Manager
 	{
 		class LightManager;
+		class MatrixDataManager;
+		class OcclusionManager;
+	}
+	namespace RenderPass
+	{
+		class OpaqueRenderPass;
 	}
 	namespace Core
 	{
 		class Window;
 		class Device;
 		class Thread;
+		class FrameSnapshot;
 		class Instance
 		{
 			friend class Graphic::Core::Window;
 			friend class Graphic::Core::Device;
 			friend class Graphic::Core::Thread;
+			friend class Graphic::RenderPass::OpaqueRenderPass;
 		public:
 			class InstanceCreator
 			{
@@ -42,6 +51,7 @@ namespace Graphic
 				std::string engineName;
 				uint32_t engineVersion;
 				uint32_t apiVersion;
+				uint32_t framesInFlight;
 #ifdef _USE_GRAPHIC_DEBUG
 				VkDebugUtilsMessageSeverityFlagsEXT messageSeverity;
 				VkDebugUtilsMessageTypeFlagsEXT messageType;
@@ -67,22 +77,30 @@ namespace Graphic
 			static void Create(InstanceCreator& creator);
 			static VkInstance VkInstance_();
 
-			static Utils::Condition& RenderStartCondition();
-			static Utils::Condition& RenderEndCondition();
+			static uint32_t FramesInFlight();
+			static void AcquireLogicFrame();
 			static void AddLight(std::vector<Logic::Component::Component*>& lights);
 			static void AddCamera(std::vector<Logic::Component::Component*>& cameras);
 			static void AddRenderer(std::vector<Logic::Component::Component*>& renderers);
+			static void SubmitLogicFrame();
 
 		private:
 			static Command::CommandPool* presentCommandPool;
 			static Command::CommandBuffer* presentCommandBuffer;
 			static Manager::LightManager* lightManager;
-			static Utils::Condition* _renderStartCondition;
-			static Utils::Condition* _renderEndCondition;
+			static Manager::MatrixDataManager* matrixDataManager;
+			static Manager::OcclusionManager* occlusionManager;
 
-			static std::vector<Logic::Component::Component*> _lights;
-			static std::vector<Logic::Component::Component*> _cameras;
-			static std::vector<Logic::Component::Component*> _renderers;
+			static std::vector<FrameSnapshot*> _frameSnapshots;
+			static uint32_t _logicFrameIndex;
+			static uint32_t _renderFrameIndex;
+			static uint32_t _submittedFrameCount;
+			static uint32_t _pendingFrameCount;
+			static std::mutex _frameMutex;
+			static std::condition_variable _frameVariable;
+			static void _CreateFrameSnapshots(InstanceCreator& creator);
+			static FrameSnapshot* _AcquireRenderFrame();
+			static void _ReleaseRenderFrame();
 
 			static VkInstance _vkInstance;
 			static void _AddWindowExtension(InstanceCreator& creator);
@@ -1,17 +1,16 @@
 #pragma once
 #include "Utils/ThreadBase.h"
 #include <vector>
-#include <queue>
 #include <memory>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <functional>
 #include <future>
+#include <tuple>
 #include <vulkan/vulkan_core.h>
 #include <memory>
 #include <map>
 #include "Utils/Log.h"
+#include "Utils/JobSystem.h"
 #include "Graphic/Command/CommandPool.h"
 #include "Graphic/Command/CommandBuffer.h"
 
@@ -44,13 +43,14 @@ namespace Graphic
 			private:
 				Graphic::Command::CommandPool* _commandPool;
 				RenderThread* _parentRenderThread;
+				uint32_t _workerIndex;
 
 				SubRenderThread(const SubRenderThread&) = delete;
 				SubRenderThread& operator=(const SubRenderThread&) = delete;
 				SubRenderThread(SubRenderThread&&) = delete;
 				SubRenderThread& operator=(SubRenderThread&&) = delete;
 			public:
-				SubRenderThread(RenderThread* renderThread);
+				SubRenderThread(RenderThread* renderThread, uint32_t workerIndex);
 				~SubRenderThread();
 
 				void RestCommandPool();
@@ -76,9 +76,7 @@ namespace Graphic
 				void OnRun() override;
 				void OnEnd() override;
 
-				std::queue<std::function<void(Graphic::Command::CommandPool*)>> _tasks;
-				std::mutex _queueMutex;
-				std::condition_variable _queueVariable;
+				Utils::JobSystem<Graphic::Command::CommandPool*> _jobSystem;
 				template<typename F, typename... Args>
 				std::future<Graphic::Command::CommandBuffer*> AddTask(F&& f, Args&&... args);
 			};
@@ -91,6 +89,8 @@ namespace Graphic
 			static void Start();
 			static void End();
 			static void WaitForStartFinish();
+			static size_t SubRenderThreadCount();
+			static std::future<Graphic::Command::CommandBuffer*> AddRenderTask(std::function<Graphic::Command::CommandBuffer*(Graphic::Command::CommandPool*)> task);
 		};
 
 	}
@@ -99,20 +99,22 @@ namespace Graphic
 template<typename F, typename ...Args>
 std::future<Graphic::Command::CommandBuffer*> Graphic::Core::Thread::RenderThread::AddTask(F&& f, Args && ...args)
 {
-	auto task = std::make_shared<std::packaged_task<Graphic::Command::CommandBuffer* (Graphic::Command::CommandPool*)> >(
-		std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...)
-		);
+	Utils::Log::Exception("Can not add new render task when renderthread stopped.", _stopped);
 
-	std::future<Graphic::Command::CommandBuffer*> res = task->get_future();
-	{
-		std::unique_lock<std::mutex> lock(_queueMutex);
-
-		// don't allow enqueueing after stopping the pool
-		Utils::Log::Exception("Can not add new render task when renderthread stopped.", _stopped);
-
-		_tasks.emplace([task](Graphic::Command::CommandPool* renderCommandPool) { (*task)(renderCommandPool); });
-	}
-	_queueVariable.notify_one();
+	std::promise<Graphic::Command::CommandBuffer*> promise;
+	std::future<Graphic::Command::CommandBuffer*> res = promise.get_future();
+	_jobSystem.Submit(
+		[promise = std::move(promise), function = std::forward<F>(f), arguments = std::make_tuple(std::forward<Args>(args)...)](Graphic::Command::CommandPool* renderCommandPool) mutable
+		{
+			try
+			{
+				promise.set_value(std::apply(function, std::tuple_cat(std::make_tuple(renderCommandPool), std::move(arguments))));
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		}
+	);
 	return res;
-
 }
@@ -5,6 +5,10 @@
 namespace Graphic
 {
 	class CommandBuffer;
+	namespace Command
+	{
+		class CommandBuffer;
+	}
 	namespace Instance
 	{
 		class Memory;
@@ -15,7 +19,9 @@ namespace Graphic
 			Memory _memoryBlock;
 			size_t _size;
 			VkBufferUsageFlags _usage;
+			bool _movable;
 
+			std::function<void()> _Move(Command::CommandBuffer* commandBuffer);
 			Buffer(const Buffer& source) = delete;
 			Buffer& operator=(const Buffer&) = delete;
 			Buffer(Buffer&&) = delete;
@@ -24,6 +30,8 @@ namespace Graphic
 			Buffer(size_t size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
 			void WriteBuffer(const void* data, size_t dataSize);
 			void WriteBuffer(std::function<void(void*)> writeFunction);
+			//Lets defragmentation move the buffer, its VkBuffer changes afterwards so only handles fetched at record time stay valid
+			void EnableMove();
 			inline VkBuffer VkBuffer_();
 			inline Memory& Memory();
 			inline size_t Size();
@@ -20,8 +20,9 @@ namespace Graphic
 			VkDeviceSize _offset;
 			VkDeviceSize _size;
 			std::mutex* _mutex;
-			Memory(uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, VkMemoryPropertyFlags property);
-			Memory(bool isExclusive, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, VkMemoryPropertyFlags property);
+			void* _mappedData;
+			Memory(uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, void* mappedData, VkMemoryPropertyFlags property);
+			Memory(bool isExclusive, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, void* mappedData, VkMemoryPropertyFlags property);
 		public:
 			Memory();
 			~Memory();
@@ -30,6 +31,8 @@ namespace Graphic
 			VkDeviceSize Size();
 			VkDeviceMemory VkMemory();
 			VkMemoryPropertyFlags Properties();
+			//Host visible memory stays mapped for its lifetime, nullptr otherwise
+			void* MappedData();
 		};
 
 	}
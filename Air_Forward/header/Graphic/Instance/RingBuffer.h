@@ -0,0 +1,53 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "Graphic/Instance/Memory.h"
+namespace Graphic
+{
+	namespace Instance
+	{
+		class RingBuffer
+		{
+		private:
+			struct _RetiredBuffer
+			{
+				VkBuffer vkBuffer;
+				Memory memoryBlock;
+				uint32_t remainingFrameCount;
+			};
+			VkBuffer _vkBuffer;
+			Memory _memoryBlock;
+			char* _mappedData;
+			VkBufferUsageFlags _usage;
+			VkDeviceSize _alignment;
+			VkDeviceSize _frameSize;
+			uint32_t const _frameCount;
+			uint32_t _frameIndex;
+			std::atomic<VkDeviceSize> _frameOffset;
+			uint32_t _version;
+			std::vector<_RetiredBuffer> _retiredBuffers;
+
+			void _Create();
+			void _Destroy(VkBuffer vkBuffer, Memory& memoryBlock);
+
+			RingBuffer(const RingBuffer& source) = delete;
+			RingBuffer& operator=(const RingBuffer&) = delete;
+			RingBuffer(RingBuffer&&) = delete;
+			RingBuffer& operator=(RingBuffer&&) = delete;
+		public:
+			//One persistently mapped segment per frame in flight
+			RingBuffer(VkDeviceSize frameSize, uint32_t frameCount, VkBufferUsageFlags usage);
+			~RingBuffer();
+			//The old buffer is destroyed once a full ring of frames has passed, frames still in flight keep reading it
+			void Resize(VkDeviceSize frameSize);
+			void NextFrame();
+			//Returns the dynamic offset of an aligned range in the current frame
+			uint32_t Allocate(VkDeviceSize size, void** data);
+			VkBuffer VkBuffer_();
+			VkDeviceSize Range();
+			uint32_t Version();
+		};
+	}
+}
\ No newline at end of file
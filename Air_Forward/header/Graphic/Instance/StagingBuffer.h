@@ -0,0 +1,41 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+#include <vector>
+namespace Graphic
+{
+	namespace Instance
+	{
+		class Buffer;
+		class StagingBuffer
+		{
+		public:
+			struct Allocation
+			{
+				Buffer* buffer;
+				VkDeviceSize offset;
+				void* data;
+			};
+		private:
+			Buffer* _buffer;
+			char* _mappedData;
+			VkDeviceSize _size;
+			VkDeviceSize _head;
+			std::vector<Buffer*> _retiredBuffers;
+
+			StagingBuffer(const StagingBuffer& source) = delete;
+			StagingBuffer& operator=(const StagingBuffer&) = delete;
+			StagingBuffer(StagingBuffer&&) = delete;
+			StagingBuffer& operator=(StagingBuffer&&) = delete;
+		public:
+			//Persistently mapped linear allocator for upload sources
+			StagingBuffer(VkDeviceSize size);
+			~StagingBuffer();
+			//Grows when the request does not fit, the outgrown buffer lives until Reset
+			Allocation Allocate(VkDeviceSize size, VkDeviceSize alignment);
+			//Every copy reading earlier allocations must have finished
+			void Reset();
+			VkDeviceSize Size();
+			VkDeviceSize Used();
+		};
+	}
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <array>
 #include <glm/glm.hpp>
 #include <vector>
+#include "Graphic/Core/FrameSnapshot.h"
 
 namespace Logic
 {
@@ -48,7 +49,7 @@ namespace Graphic
 				alignas(16) glm::vec3 position;
 				alignas(16) glm::vec4 color;
 			};
-			void SetLightData(std::vector<Logic::Component::Component*> lights);
+			void SetLightData(std::vector<Core::FrameSnapshot::LightSnapshot>& lights);
 			void CopyLightData(Command::CommandBuffer* commandBuffer);
 			LightManager();
 			~LightManager();
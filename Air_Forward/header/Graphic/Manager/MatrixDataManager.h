@@ -0,0 +1,52 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace Graphic
+{
+	namespace Instance
+	{
+		class RingBuffer;
+	}
+	namespace Manager
+	{
+		class MatrixDataManager final
+		{
+		public:
+			struct MatrixData
+			{
+				alignas(16) glm::mat4 view;
+				alignas(16) glm::mat4 projection;
+			};
+			struct InstanceData
+			{
+				alignas(16) glm::mat4 model;
+				alignas(16) glm::mat4 itModel;
+			};
+			void SetMatrixData(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+			void Reserve(size_t instanceCount);
+			uint32_t AddInstanceData(const glm::mat4& modelMatrix);
+			void CopyMatrixData();
+			void Clear();
+			Instance::RingBuffer* MatrixDataBuffer();
+			uint32_t DynamicOffset();
+			MatrixDataManager();
+			~MatrixDataManager();
+		private:
+			Instance::RingBuffer* _matrixDataBuffer;
+			size_t _instanceCapacity;
+			MatrixData _matrixData;
+			MatrixData* _frameMatrixData;
+			InstanceData* _frameInstanceDatas;
+			size_t _frameInstanceCapacity;
+			size_t _frameInstanceCount;
+			uint32_t _dynamicOffset;
+
+			MatrixDataManager(const MatrixDataManager&) = delete;
+			MatrixDataManager& operator=(const MatrixDataManager&) = delete;
+			MatrixDataManager(MatrixDataManager&&) = delete;
+			MatrixDataManager& operator=(MatrixDataManager&&) = delete;
+		};
+	}
+}
\ No newline at end of file
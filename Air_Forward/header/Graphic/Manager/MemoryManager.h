@@ -3,48 +3,112 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <memory>
+#include <string>
+#include <functional>
+#include <set>
+#include "Utils/TlsfAllocator.h"
 namespace Graphic
 {
 	namespace Instance
 	{
 		class Memory;
 	}
+	namespace Command
+	{
+		class CommandBuffer;
+	}
 	namespace Manager
 	{
 		class MemoryManager
 		{
-		private:
-			class MemoryChunkUsage
+		public:
+			struct MemoryTypeStatistics
 			{
-			public:
-				VkDeviceSize offset;
+				uint32_t heapIndex;
+				VkMemoryPropertyFlags propertyFlags;
+				uint32_t chunkCount;
+				VkDeviceSize chunkBytes;
+				VkDeviceSize allocatedBytes;
+				VkDeviceSize freeBytes;
+				VkDeviceSize largestFreeBlock;
+				uint32_t allocationCount;
+				uint32_t exclusiveAllocationCount;
+				VkDeviceSize exclusiveBytes;
+			};
+			struct MemoryHeapStatistics
+			{
+				VkMemoryHeapFlags flags;
 				VkDeviceSize size;
-				MemoryChunkUsage(VkDeviceSize start, VkDeviceSize size);
-				MemoryChunkUsage();
+				//Usage and budget come from VK_EXT_memory_budget, without it usage only counts this manager's memory and budget is the heap size
+				VkDeviceSize usage;
+				VkDeviceSize budget;
+				bool hasBudget;
+			};
+			struct MemoryStatistics
+			{
+				std::vector<MemoryTypeStatistics> types;
+				std::vector<MemoryHeapStatistics> heaps;
 			};
+		private:
 			class MemoryChunk
 			{
 			public:
 				VkDeviceMemory memory;
 				VkDeviceSize size;
 				std::mutex* const mutex;
-				std::map<VkDeviceSize, MemoryChunkUsage> allocated;
-				std::map<VkDeviceSize, MemoryChunkUsage> unallocated;
-				MemoryChunk(uint32_t typeIndex, VkDeviceSize size);
+				char* mappedData;
+				Utils::TlsfAllocator allocator;
+				bool draining;
+				uint32_t emptyCollectCount;
+				MemoryChunk(uint32_t typeIndex, VkDeviceSize size, bool hostVisible);
 				~MemoryChunk();
 			};
 		private:
 			std::vector<std::map<VkDeviceMemory, std::shared_ptr<MemoryChunk>>> _chunkSets;
 			std::vector< VkMemoryPropertyFlags> _propertys;
 			std::vector<std::mutex*> _chunkSetMutexs;
+			std::vector<uint32_t> _exclusiveCounts;
+			std::vector<VkDeviceSize> _exclusiveSizes;
+			std::vector<uint32_t> _heapIndexs;
 			VkDeviceSize const _defaultSize;
+
+			static const uint32_t EMPTY_CHUNK_COLLECT_COUNT = 120;
+			std::map<Instance::Memory*, std::function<std::function<void()>(Command::CommandBuffer*)>> _movables;
+			std::vector<std::function<void()>> _pendingReleases;
+			std::set<Instance::Memory*> _movingMemories;
+			std::mutex _movableMutex;
+			uint32_t _defragmentTypeIndex;
+			VkDeviceMemory _defragmentMemory;
+			VkDeviceSize _defragmentBudget;
+			float _defragmentUsageRatio;
+
+			static void* _Map(VkDeviceMemory memory, VkDeviceSize size, VkMemoryPropertyFlags properties);
+			Instance::Memory _AllocateExclusive(uint32_t typeIndex, VkDeviceSize size, VkMemoryPropertyFlags properties);
 		public:
 			MemoryManager(VkDeviceSize defaultSize);
 			~MemoryManager();
 			Instance::Memory AcquireMemory(VkMemoryRequirements& requirement, VkMemoryPropertyFlags properties);
 			Instance::Memory AcquireExclusiveMemory(VkMemoryRequirements& requirement, VkMemoryPropertyFlags properties);
 			void ReleaseMemBlock(Instance::Memory& memoryBlock);
+			MemoryStatistics Statistics();
+			std::string StatisticsJson();
+			//Logs and returns true when any heap uses more than usageRatio of its budget
+			bool CheckBudget(float usageRatio);
 
+			//Frees chunks that stayed empty for EMPTY_CHUNK_COLLECT_COUNT calls, one empty chunk per memory type is kept
+			void CollectEmptyChunks();
+			//The move function records a copy into newly acquired memory and returns the release of the old resource
+			void RegisterMovable(Instance::Memory& memory, std::function<std::function<void()>(Command::CommandBuffer*)> move);
+			//Builds the release under the move lock, then runs it now or at FinishDefragment when the memory is the destination of a move still in flight
+			void UnregisterMovable(Instance::Memory& memory, std::function<std::function<void()>()> release);
+			//Defragmentation is off until a byte budget per pass is set
+			void SetDefragmentBudget(VkDeviceSize bytesPerPass, float usageRatio);
+			VkDeviceSize DefragmentBudget();
+			//Records moves out of the sparsest chunk below the usage ratio, returns whether anything was recorded
+			bool Defragment(Command::CommandBuffer* commandBuffer);
+			//Releases moved resources, commandBuffer passed to Defragment must have finished
+			void FinishDefragment();
 		};
 	}
 }
\ No newline at end of file
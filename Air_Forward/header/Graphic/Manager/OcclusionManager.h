@@ -0,0 +1,48 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vulkan/vulkan_core.h>
+#include "Utils/DepthPyramid.h"
+
+namespace Graphic
+{
+	namespace Instance
+	{
+		class Buffer;
+		class Image;
+	}
+	namespace Command
+	{
+		class CommandBuffer;
+	}
+	namespace Manager
+	{
+		//Reads the opaque depth of one frame back to build the pyramid the next frame is culled against
+		class OcclusionManager final
+		{
+		public:
+			//Builds from the depth copied last frame, then takes this frame's matrix for the coming copy
+			void BuildDepthPyramid(const glm::mat4& viewProjection);
+			//Recorded after the opaque pass, leaves the depth image in attachment layout
+			void CopyDepth(Command::CommandBuffer* commandBuffer, Instance::Image* depthImage);
+			const Utils::DepthPyramid& DepthPyramid();
+			void SetEnable(bool enable);
+			bool Enabled();
+			OcclusionManager();
+			~OcclusionManager();
+		private:
+			Instance::Buffer* _readbackBuffer;
+			VkExtent2D _extent;
+			Utils::DepthPyramid _depthPyramid;
+			glm::mat4 _viewProjection;
+			glm::mat4 _copiedViewProjection;
+			bool _copied;
+			bool _enable;
+			VkDeviceSize _nonCoherentAtomSize;
+
+			OcclusionManager(const OcclusionManager&) = delete;
+			OcclusionManager& operator=(const OcclusionManager&) = delete;
+			OcclusionManager(OcclusionManager&&) = delete;
+			OcclusionManager& operator=(OcclusionManager&&) = delete;
+		};
+	}
+}
\ No newline at end of file
@@ -23,6 +23,7 @@ namespace Graphic
 	namespace Instance
 	{
 		class Buffer;
+		class RingBuffer;
 		class DescriptorSet;
 		typedef DescriptorSet* DescriptorSetHandle;
 	}
@@ -38,6 +39,8 @@ namespace Graphic
 			Asset::SlotType slotType;
 			Instance::DescriptorSetHandle descriptorSet;
 			uint32_t set;
+			uint32_t dynamicOffset;
+			uint32_t bufferVersion;
 		};
 
 	private:
@@ -52,9 +55,14 @@ namespace Graphic
 		void SetSlotData(std::string name, std::vector<uint32_t> bindingIndex, std::vector< Graphic::Instance::DescriptorSet::DescriptorSetWriteData> data);
 		const Instance::Buffer* GetUniformBuffer(const char* name);
 		void SetUniformBuffer(const char* name, Instance::Buffer* buffer);
+		const Instance::Buffer* GetStorageBuffer(const char* name);
+		void SetStorageBuffer(const char* name, Instance::Buffer* buffer);
+		void SetUniformBuffer(const char* name, Instance::RingBuffer* ringBuffer, uint32_t dynamicOffset);
+		void SetStorageBuffer(const char* name, Instance::RingBuffer* ringBuffer, uint32_t dynamicOffset);
 		void RefreshSlotData(std::vector<std::string> slotNames);
 		VkPipelineLayout PipelineLayout();
 		std::vector<VkDescriptorSet> DescriptorSets();
+		std::vector<uint32_t> DynamicOffsets();
 		Asset::Shader& Shader();
 
 		~Material();
@@ -1,5 +1,6 @@
 #pragma once
 #include "Graphic/RenderPass/RenderPass.h"
+#include <vector>
 
 namespace Graphic
 {
@@ -17,16 +18,21 @@ namespace Graphic
 		class OpaqueRenderPass: public RenderPass
 		{
 		private:
+			static const size_t MIN_CHUNK_BATCH_COUNT = 64;
 			Command::CommandBuffer* _renderCommandBuffer;
 			Command::CommandPool* _renderCommandPool;
+			std::vector<Command::CommandBuffer*> _chunkCommandBuffers;
+			std::vector<Command::CommandPool*> _chunkCommandPools;
 			Instance::FrameBuffer* _frameBuffer;
 			Instance::Attachment* _colorAttachment;
 			Instance::Attachment* _depthAttachment;
 			virtual void OnCreate(Graphic::Manager::RenderPassManager::RenderPassCreator& creator);
 			virtual void OnPrepare();
-			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable);
+			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList);
 			virtual void OnRender();
 			virtual void OnClear();
+			virtual Core::DrawList::SortMode DrawListSortMode();
+			Command::CommandBuffer* _RecordChunk(Command::CommandPool* commandPool, Core::DrawList& drawList, uint32_t subpassIndex, size_t chunkIndex, size_t chunkSize);
 		public:
 			OpaqueRenderPass();
 			~OpaqueRenderPass();
@@ -4,16 +4,7 @@
 #include <map>
 #include <vector>
 #include "Graphic/Manager/RenderPassManager.h"
-namespace Logic
-{
-	namespace Component
-	{
-		namespace Renderer
-		{
-			class Renderer;
-		}
-	}
-}
+#include "Graphic/Core/DrawList.h"
 namespace Graphic
 {
 	namespace Command
@@ -51,9 +42,10 @@ namespace Graphic
 
 			virtual void OnCreate(Graphic::Manager::RenderPassManager::RenderPassCreator& creator) = 0;
 			virtual void OnPrepare() = 0;
-			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable) = 0;
+			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList) = 0;
 			virtual void OnRender() = 0;
 			virtual void OnClear() = 0;
+			virtual Core::DrawList::SortMode DrawListSortMode();
 		public:
 			std::string Name();
 			uint32_t RenderIndex();
@@ -24,7 +24,7 @@ namespace Graphic
 			Instance::Attachment* _depthAttachment;
 			virtual void OnCreate(Graphic::Manager::RenderPassManager::RenderPassCreator& creator);
 			virtual void OnPrepare();
-			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable);
+			virtual void OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList);
 			virtual void OnRender();
 			virtual void OnClear();
 		public:
@@ -3,6 +3,9 @@
 #include <mutex>
 #include <map>
 #include <future>
+#include <functional>
+#include <vector>
+#include <exception>
 #include <iostream>
 #include "IO/Core/Thread.h"
 #include "Utils/Log.h"
@@ -55,8 +58,17 @@ namespace IO
 			friend class Manager::AssetManager;
 		private:
 			inline virtual void _LoadAssetInstance(Graphic::Command::CommandBuffer* const transferCommandBuffer) = 0;
-			inline void _Wait();
+			//Bytes kept alive by a loaded instance, counted against its type's cache budget
+			virtual size_t _ResidentSize() = 0;
+			//Runs the callback once loading has finished, right away if it already has, a failed load passes its exception
+			inline void _OnReady(std::function<void(std::exception_ptr)> callback);
+			inline void _SetReady(std::exception_ptr exception);
+			inline bool _Ready();
+			std::mutex _readyMutex;
 			bool _readyToUse;
+			std::exception_ptr _loadException;
+			std::vector<std::function<void(std::exception_ptr)>> _readyCallbacks;
+			uint32_t _pathId;
 		protected:
 			std::string const path;
 			IAssetInstance(std::string path);
@@ -66,61 +78,91 @@ namespace IO
 	}
 }
 
-inline void IO::Asset::IAssetInstance::_Wait()
+inline void IO::Asset::IAssetInstance::_OnReady(std::function<void(std::exception_ptr)> callback)
 {
-	while (!this->_readyToUse)
 	{
-		std::this_thread::yield();
+		std::unique_lock<std::mutex> lock(_readyMutex);
+		if (!_readyToUse)
+		{
+			_readyCallbacks.emplace_back(std::move(callback));
+			return;
+		}
+	}
+	callback(_loadException);
+}
+
+inline void IO::Asset::IAssetInstance::_SetReady(std::exception_ptr exception)
+{
+	std::vector<std::function<void(std::exception_ptr)>> readyCallbacks;
+	{
+		std::unique_lock<std::mutex> lock(_readyMutex);
+		_loadException = exception;
+		_readyToUse = true;
+		readyCallbacks.swap(_readyCallbacks);
+	}
+	for (auto& readyCallback : readyCallbacks)
+	{
+		readyCallback(exception);
 	}
 }
 
+inline bool IO::Asset::IAssetInstance::_Ready()
+{
+	std::unique_lock<std::mutex> lock(_readyMutex);
+	return _readyToUse;
+}
+
 template<typename TAsset, typename TAssetInstance>
 inline std::future<TAsset*> IO::Asset::IAsset::_LoadAsync(std::string path)
 {
-	TAssetInstance* assetInstance = nullptr;
 	TAsset* newAsset = new TAsset();
-	bool alreadyCreated = false;
-
+	bool created = false;
+	TAssetInstance* assetInstance = dynamic_cast<TAssetInstance*>(IO::Core::Instance::assetManager._AcquireInstance(path, typeid(TAsset), dynamic_cast<IAsset*>(newAsset), [&path]()
 	{
-		auto& manager = IO::Core::Instance::assetManager;
-
-		std::unique_lock<std::mutex> lock(manager._managerMutex);
-
-		if (manager._ContainsInstance(path))
-		{
-			assetInstance = dynamic_cast<TAssetInstance*>(manager._AcquireInstance(path, dynamic_cast<IAsset*>(newAsset)));
-			alreadyCreated = true;
-		}
-		else
-		{
-			assetInstance = new TAssetInstance(path);
-			manager._AddInstance(path, dynamic_cast<IAssetInstance*>(assetInstance));
-			manager._AcquireInstance(path, dynamic_cast<IAsset*>(newAsset));
-			alreadyCreated = false;
-		}
-	}
+		return dynamic_cast<IAssetInstance*>(new TAssetInstance(path));
+	}, created));
+	bool alreadyCreated = !created;
 	dynamic_cast<IAsset*>(newAsset)->_assetInstance = dynamic_cast<IAssetInstance*>(assetInstance);
 	std::string sPath = std::string(path);
-	if (alreadyCreated)
+
+	//Duplicate loads of an in flight asset only queue a callback, no thread waits for them
+	auto promise = std::make_shared<std::promise<TAsset*>>();
+	std::future<TAsset*> future = promise->get_future();
+	dynamic_cast<IAssetInstance*>(assetInstance)->_OnReady([sPath, newAsset, promise, alreadyCreated](std::exception_ptr exception)
 	{
-		return std::async([assetInstance, sPath, newAsset]()
+		if (exception)
 		{
-			dynamic_cast<IAssetInstance*>(assetInstance)->_Wait();
-			Utils::Log::Message("AssetManager load " + sPath + " from asset pool.");
-			return newAsset;
-		});
-	}
-	else
+			promise->set_exception(exception);
+			return;
+		}
+		Utils::Log::Message("AssetManager load " + sPath + (alreadyCreated ? " from asset pool." : " from disk."));
+		promise->set_value(newAsset);
+	});
+
+	if (!alreadyCreated)
 	{
-		return IO::Core::Thread::AddTask([assetInstance, sPath, newAsset](Graphic::Command::CommandBuffer* const tcb)
+		IO::Core::Thread::AddTask([assetInstance](Graphic::Command::CommandBuffer* const tcb)
 		{
-			dynamic_cast<IAssetInstance*>(assetInstance)->_LoadAssetInstance(tcb);
-			dynamic_cast<IAssetInstance*>(assetInstance)->_readyToUse = true;
-			dynamic_cast<IAssetInstance*>(assetInstance)->_Wait();
-			Utils::Log::Message("AssetManager load " + sPath + " from disk.");
-			return newAsset;
+			try
+			{
+				dynamic_cast<IAssetInstance*>(assetInstance)->_LoadAssetInstance(tcb);
+			}
+			catch (...)
+			{
+				dynamic_cast<IAssetInstance*>(assetInstance)->_SetReady(std::current_exception());
+				return;
+			}
+
+			//Ready once the batch holding its uploads has finished on gpu
+			auto& uploadBatcher = IO::Core::Thread::CurrentUploadBatcher();
+			uploadBatcher.OnFinish([assetInstance]()
+			{
+				dynamic_cast<IAssetInstance*>(assetInstance)->_SetReady(nullptr);
+			});
+			uploadBatcher.EndUpload();
 		});
 	}
+	return future;
 }
 
 template<typename TAsset, typename TAssetInstance>
@@ -133,8 +175,7 @@ template<typename TAsset, typename TAssetInstance>
 inline void IO::Asset::IAsset::_Unload(TAsset* asset)
 {
 	auto& manager = IO::Core::Instance::assetManager;
-	
-	std::unique_lock<std::mutex> lock(manager._managerMutex);
+
 	std::string unloaded = asset->_assetInstance->path;
 	manager._ReleaseInstance(asset->_assetInstance, asset);
 	delete asset;
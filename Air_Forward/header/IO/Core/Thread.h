@@ -1,17 +1,17 @@
 #pragma once
 #include "Utils/ThreadBase.h"
 #include <vector>
-#include <queue>
 #include <memory>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <functional>
 #include <future>
+#include <tuple>
 #include <vulkan/vulkan_core.h>
 #include <memory>
 #include <map>
 #include "Utils/Log.h"
+#include "Utils/JobSystem.h"
+#include "IO/Core/UploadBatcher.h"
 
 namespace Graphic
 {
@@ -20,6 +20,10 @@ namespace Graphic
 		class CommandPool;
 		class CommandBuffer;
 	}
+	namespace Instance
+	{
+		class StagingBuffer;
+	}
 }
 namespace IO
 {
@@ -61,9 +65,11 @@ namespace IO
 				friend class Thread;
 			private:
 				Graphic::Command::CommandPool* _transferCommandPool;
-				Graphic::Command::CommandBuffer* _transferCommandBuffer;
+				Graphic::Command::CommandPool* _acquireCommandPool;
+				UploadBatcher* _uploadBatcher;
+				uint32_t _workerIndex;
 			public:
-				SubLoadThread();
+				SubLoadThread(uint32_t workerIndex);
 				~SubLoadThread();
 
 				SubLoadThread(const SubLoadThread&) = delete;
@@ -78,15 +84,17 @@ namespace IO
 			};
 
 			static LoadThread _loadThread;
+			static thread_local UploadBatcher* _currentUploadBatcher;
 		public:
 			inline static void Init();
 			inline static void Start();
 			inline static void End();
 			inline static void WaitForStartFinish();
 
-			static std::queue<std::function<void(Graphic::Command::CommandBuffer* const)>> _tasks;
-			static std::mutex _queueMutex;
-			static std::condition_variable _queueVariable;
+			static Utils::JobSystem<UploadBatcher*> _jobSystem;
+			//Upload batcher of the calling load worker, tasks get its recording command buffer
+			static UploadBatcher& CurrentUploadBatcher();
+			static Graphic::Instance::StagingBuffer& StagingBuffer();
 			template<typename F, typename... Args>
 			inline static auto AddTask(F&& f, Args&&... args)->std::future<typename std::invoke_result<F, Graphic::Command::CommandBuffer* const, Args...>::type>;
 		};
@@ -98,20 +106,33 @@ inline auto IO::Core::Thread::AddTask(F&& f, Args && ...args) -> std::future<typ
 {
 	using return_type = typename std::invoke_result<F, Graphic::Command::CommandBuffer* const, Args...>::type;
 
-	auto task = std::make_shared<std::packaged_task<return_type(Graphic::Command::CommandBuffer* const)> >(
-		std::bind(std::forward<F>(f), std::placeholders::_1, std::forward<Args>(args)...)
-		);
-
-	std::future<return_type> res = task->get_future();
-	{
-		std::unique_lock<std::mutex> lock(_queueMutex);
-
-		// don't allow enqueueing after stopping the pool
-		Utils::Log::Exception("Can not add new load task when loadthread stopped.", _loadThread._stopped);
+	// don't allow enqueueing after stopping the pool
+	Utils::Log::Exception("Can not add new load task when loadthread stopped.", _loadThread._stopped);
 
-		_tasks.emplace([task](Graphic::Command::CommandBuffer* const transferCommandBuffer) { (*task)(transferCommandBuffer); });
-	}
-	_queueVariable.notify_one();
+	std::promise<return_type> promise;
+	std::future<return_type> res = promise.get_future();
+	_jobSystem.Submit(
+		[promise = std::move(promise), function = std::forward<F>(f), arguments = std::make_tuple(std::forward<Args>(args)...)](UploadBatcher* uploadBatcher) mutable
+		{
+			Graphic::Command::CommandBuffer* transferCommandBuffer = uploadBatcher->CommandBuffer();
+			try
+			{
+				if constexpr (std::is_void<return_type>::value)
+				{
+					std::apply(function, std::tuple_cat(std::make_tuple(transferCommandBuffer), std::move(arguments)));
+					promise.set_value();
+				}
+				else
+				{
+					promise.set_value(std::apply(function, std::tuple_cat(std::make_tuple(transferCommandBuffer), std::move(arguments))));
+				}
+			}
+			catch (...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+		}
+	);
 	return res;
 }
 
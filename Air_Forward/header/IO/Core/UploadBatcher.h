@@ -0,0 +1,80 @@
+#pragma once
+#include <vulkan/vulkan_core.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Graphic/Command/ImageMemoryBarrier.h"
+#include "Graphic/Command/BufferMemoryBarrier.h"
+namespace Graphic
+{
+	namespace Command
+	{
+		class CommandPool;
+		class CommandBuffer;
+	}
+	namespace Instance
+	{
+		class StagingBuffer;
+		class Image;
+		class Buffer;
+	}
+}
+namespace IO
+{
+	namespace Core
+	{
+		//Collects the uploads of one load worker into a few submissions kept in flight, owned and used by that worker only
+		class UploadBatcher final
+		{
+		private:
+			struct _Batch
+			{
+				Graphic::Command::CommandBuffer* commandBuffer;
+				Graphic::Command::CommandBuffer* acquireCommandBuffer;
+				Graphic::Instance::StagingBuffer* stagingBuffer;
+				std::vector<Graphic::Command::ImageMemoryBarrier> acquireImageBarriers;
+				std::vector<Graphic::Command::BufferMemoryBarrier> acquireBufferBarriers;
+				std::vector<std::function<void()>> finishCallbacks;
+				uint32_t uploadCount;
+				bool inFlight;
+			};
+			static const uint32_t MAX_UPLOAD_COUNT = 32;
+			static const VkDeviceSize FLUSH_SIZE = 16 * 1024 * 1024;
+
+			Graphic::Command::CommandPool* const _commandPool;
+			Graphic::Command::CommandPool* const _acquireCommandPool;
+			std::string const _name;
+			uint32_t _transferQueueFamilyIndex;
+			uint32_t _renderQueueFamilyIndex;
+			std::vector<_Batch> _batches;
+			uint32_t _currentBatch;
+
+			void _Begin(uint32_t batchIndex);
+			void _Finish(uint32_t batchIndex);
+			void _Acquire(uint32_t batchIndex);
+
+			UploadBatcher(const UploadBatcher&) = delete;
+			UploadBatcher& operator=(const UploadBatcher&) = delete;
+			UploadBatcher(UploadBatcher&&) = delete;
+			UploadBatcher& operator=(UploadBatcher&&) = delete;
+		public:
+			//Acquire command pool must belong to the queue that uses the uploaded resources
+			UploadBatcher(Graphic::Command::CommandPool* commandPool, Graphic::Command::CommandPool* acquireCommandPool, std::string name, uint32_t batchCount, VkDeviceSize stagingSize);
+			~UploadBatcher();
+			//Already recording, tasks only add commands to it
+			Graphic::Command::CommandBuffer* CommandBuffer();
+			Graphic::Instance::StagingBuffer& StagingBuffer();
+			//Runs on this worker once the batch holding the current uploads has finished on gpu
+			void OnFinish(std::function<void()> callback);
+			//Records the end of an upload, releasing the resource to the render queue family when uploads run on another family
+			void TransferOwnership(Graphic::Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags dstAccessFlags);
+			void TransferOwnership(Graphic::Instance::Buffer* buffer, VkAccessFlags dstAccessFlags);
+			//Closes one upload, submits the batch when it grew large enough
+			void EndUpload();
+			void Flush();
+			//Submits pending uploads and finishes completed batches, returns whether any batch is still in flight
+			bool Poll();
+			void WaitAll();
+		};
+	}
+}
\ No newline at end of file
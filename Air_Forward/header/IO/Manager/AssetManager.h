@@ -1,7 +1,13 @@
 #pragma once
 #include <cstdint>
 #include <set>
-#include <map>
+#include <array>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <typeindex>
+#include <functional>
+#include <atomic>
 #include <mutex>
 
 namespace IO
@@ -17,25 +23,76 @@ namespace IO
 		{
 			friend class Asset::IAssetInstance;
 			friend class Asset::IAsset;
+		public:
+			struct CacheStatistics
+			{
+				uint64_t hitCount;
+				uint64_t missCount;
+				uint64_t evictionCount;
+				//Unreferenced bytes kept resident after the last collection
+				size_t unusedSize;
+				size_t budget;
+			};
 		private:
+			static const uint32_t SHARD_COUNT = 16;
+			static const uint32_t NULL_INDEX = UINT32_MAX;
+
 			class _AssetInstanceWarp
 			{
 			public:
 				uint32_t refCount;
 				std::set<IO::Asset::IAsset*> assets;
 				IO::Asset::IAssetInstance* assetInstance;
+				std::type_index assetType;
+				//Intrusive list of unreferenced instances, the tick orders them for eviction
+				bool unused;
+				uint64_t unusedTick;
+				uint32_t prevUnused;
+				uint32_t nextUnused;
+			};
+			struct _Counters
+			{
+				uint64_t hitCount;
+				uint64_t missCount;
+				uint64_t evictionCount;
+			};
+			struct _EvictionCandidate
+			{
+				uint32_t shardIndex;
+				uint32_t index;
+				uint64_t unusedTick;
+				size_t size;
+			};
+			class _Shard
+			{
+			public:
+				std::mutex mutex;
+				std::unordered_map<std::string, uint32_t> pathIndexs;
+				std::vector<_AssetInstanceWarp> warps;
+				std::vector<uint32_t> freeIndexs;
+				uint32_t unusedHead;
+				std::unordered_map<std::type_index, _Counters> counters;
 			};
-			std::mutex _managerMutex;
-			std::map<std::string, _AssetInstanceWarp> _warps;
+			std::array<_Shard, SHARD_COUNT> _shards;
+			std::atomic<uint64_t> _unusedTick;
+			std::mutex _budgetMutex;
+			std::unordered_map<std::type_index, size_t> _budgets;
+			std::unordered_map<std::type_index, size_t> _unusedSizes;
 
-			void _AddInstance(std::string path, Asset::IAssetInstance* assetInstance);
-			Asset::IAssetInstance* _AcquireInstance(std::string path, Asset::IAsset* newAsset);
-			bool _ContainsInstance(std::string path);
+			//Path ids keep the shard in their low bits
+			static uint32_t _ShardIndex(const std::string& path);
+			static void _LinkUnused(_Shard& shard, uint32_t index);
+			static void _UnlinkUnused(_Shard& shard, uint32_t index);
+			static void _Evict(_Shard& shard, uint32_t index);
+			Asset::IAssetInstance* _AcquireInstance(const std::string& path, std::type_index assetType, Asset::IAsset* newAsset, std::function<Asset::IAssetInstance*()> createInstance, bool& created);
 			void _ReleaseInstance(Asset::IAssetInstance* assetInstance, Asset::IAsset* newAsset);
 		public:
 			AssetManager();
 			~AssetManager();
+			//Evicts the least recently released assets of each type above its budget, types without a budget are not cached
 			void Collect();
+			void SetBudget(std::type_index assetType, size_t budget);
+			CacheStatistics Statistics(std::type_index assetType);
 		};
 	}
 }
@@ -60,8 +60,9 @@ namespace Logic
 				const glm::mat4& ModelMatrix();
 				virtual glm::mat4 ProjectionMatrix() = 0;
 				virtual std::array<glm::vec4, 6> ClipPlanes() = 0;
-				void SetCameraData();
-				void CopyCameraData(Graphic::Command::CommandBuffer* commandBuffer);
+				std::array<glm::vec4, 6> WorldClipPlanes();
+				CameraData GetCameraData();
+				void CopyCameraData(Graphic::Command::CommandBuffer* commandBuffer, CameraData& cameraData);
 				Graphic::Instance::Buffer* CameraDataBuffer();
 			protected:
 				glm::mat4 _modelMatrix;
@@ -73,7 +74,6 @@ namespace Logic
 			private:
 				Graphic::Instance::Buffer* _stageBuffer;
 				Graphic::Instance::Buffer* _buffer;
-				CameraData _cameraData;
 
 				RTTR_ENABLE(Logic::Component::Component)
 			};
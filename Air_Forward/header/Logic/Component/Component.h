@@ -19,6 +19,10 @@ namespace Logic
 	}
 	namespace Component
 	{
+		namespace Transform
+		{
+			class Transform;
+		}
 		class Component
 			: public Object::Object
 			, public Utils::ActivableBase
@@ -28,6 +32,7 @@ namespace Logic
 			friend class Logic::Object::GameObject;
 			friend class Manager::ObjectFactory;
 			friend class Core::Thread;
+			friend class Transform::Transform;
 		public:
 			enum class ComponentType
 			{
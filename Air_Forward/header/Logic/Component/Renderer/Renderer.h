@@ -1,8 +1,11 @@
 #pragma once
 #pragma once
 #include "Logic/Component/Component.h"
+#include "Logic/Core/Instance.h"
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 #include <array>
+#include <cstdint>
 
 namespace Graphic
 {
@@ -20,29 +23,40 @@ namespace Logic
 {
 	namespace Component
 	{
+		namespace Transform
+		{
+			class Transform;
+		}
 		namespace Renderer
 		{
 			class Renderer : public Logic::Component::Component
 			{
+				friend class Logic::Core::Instance::RendererTree;
+				friend class Logic::Component::Transform::Transform;
+			private:
+				uint32_t _rendererTreeProxy;
+				uint64_t _boundsVersion;
+				Graphic::Asset::Mesh* _boundsMesh;
+				glm::vec3 _boundsMin;
+				glm::vec3 _boundsMax;
+				bool _UpdateBounds();
+				void _UpdateRendererTree(bool boundsChanged);
+				//Moves the leaf right away, renderers off screen are never updated by the logic thread
+				void _OnTransformChanged();
 			protected:
-				struct MatrixData
-				{
-					alignas(16) glm::mat4 model;
-					alignas(16) glm::mat4 view;
-					alignas(16) glm::mat4 projection;
-					alignas(16) glm::mat4 itModel;
-				};
-				Graphic::Instance::Buffer* _matrixBuffer;
 				glm::mat4 _modelMatrix;
 				void OnUpdate() override;
 				Renderer();
 				virtual ~Renderer();
 			public:
+				//Mesh and culling changes reach the tree on the next update, which only visible renderers get
 				bool enableFrustumCulling;
 				Graphic::Asset::Mesh* mesh;
 				Graphic::Material* material;
-				void SetMatrixData(glm::mat4& viewMatrix, glm::mat4& projectionMatrix);
 				const glm::mat4& ModelMatrix();
+				//World space axis aligned bounds, only valid while the renderer has a mesh
+				const glm::vec3& BoundsMin();
+				const glm::vec3& BoundsMax();
 				RTTR_ENABLE(Logic::Component::Component)
 			};
 		}
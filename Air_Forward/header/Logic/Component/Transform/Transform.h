@@ -2,6 +2,7 @@
 #include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <cstdint>
 #include "Logic/Component/Component.h"
 
 namespace Logic
@@ -29,6 +30,9 @@ namespace Logic
 
 				glm::mat4 _modelMatrix;
 				glm::mat4 _relativeModelMatrix;
+				//Stamped from one counter whenever the model matrix changes, readers keep the stamp they saw as their dirty flag
+				static uint64_t _modelMatrixVersionCounter;
+				uint64_t _modelMatrixVersion;
 
 			public:
 				void SetTranslation(glm::vec3 translation);
@@ -41,6 +45,7 @@ namespace Logic
 				glm::mat4 RotationMatrix();
 				glm::mat4 ScaleMatrix();
 				glm::mat4 ModelMatrix();
+				uint64_t ModelMatrixVersion();
 
 				glm::vec3 Rotation();
 				glm::vec3 EulerRotation();
@@ -3,6 +3,9 @@
 #include <unordered_set>
 #include <Utils/Condition.h>
 #include "Utils/Time.h"
+#include "Utils/DynamicBvh.h"
+#include <glm/vec3.hpp>
+#include <vector>
 
 namespace Logic
 {
@@ -13,6 +16,14 @@ namespace Logic
 	namespace Component
 	{
 		class Component;
+		namespace Camera
+		{
+			class Camera;
+		}
+		namespace Renderer
+		{
+			class Renderer;
+		}
 	}
 	namespace Core
 	{
@@ -49,8 +60,31 @@ namespace Logic
 				inline double DeltaDuration();
 				inline double LaunchDuration();
 			};
+			//World bounds of every frustum culled renderer, maintained by the renderers themselves
+			class RendererTree final
+			{
+				friend class Core::Instance;
+				friend class Core::Thread;
+				friend class Component::Renderer::Renderer;
+			private:
+				Utils::DynamicBvh _bvh;
+				//Renderers without a leaf, kept by the renderers themselves and drawn every frame
+				std::unordered_set<Component::Renderer::Renderer*> _untrackedRenderers;
+				std::vector<void*> _results;
+				RendererTree();
+				~RendererTree();
+				static bool _InScene(Component::Renderer::Renderer* renderer);
+				//Keeps renderers that are outside the tree and tree renderers inside the camera frustum, every renderer without a camera
+				void Cull(Component::Camera::Camera* camera, std::vector<Component::Component*>& visibleRenderers);
+			public:
+				//Nearest first, tested against enlarged bounds so callers refine the hits
+				void RayCast(glm::vec3 origin, glm::vec3 direction, float maxDistance, std::vector<Component::Renderer::Renderer*>& renderers);
+				void Query(glm::vec3 boundsMin, glm::vec3 boundsMax, std::vector<Component::Renderer::Renderer*>& renderers);
+				uint32_t Count();
+			};
 			static RootGameObject rootObject;
 			static Time time;
+			static RendererTree rendererTree;
 			static void Exit();
 			static void WaitExit();
 		private:
@@ -35,6 +35,7 @@ namespace Logic
 		{
 			friend class Manager::ObjectFactory;
 			friend class Core::Thread;
+			friend class Component::Transform::Transform;
 		private:
 			Utils::CrossLinkableColHead _timeSqueueComponentsHead;
 			std::map<Component::Component::ComponentType, std::unique_ptr< Utils::CrossLinkableRowHead>> _typeSqueueComponentsHeadMap;
@@ -0,0 +1,17 @@
+#pragma once
+#include <cstddef>
+
+namespace Test
+{
+	//Times the per object corner check against the batch bounds check, needs no window or device
+	class CullBenchmark final
+	{
+	private:
+		static void _Run(size_t boundsCount);
+
+		CullBenchmark() = delete;
+	public:
+		//Logs both paths at 10k, 100k and 1M bounds
+		static void Run();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+namespace Utils
+{
+	class BoundedQueue
+	{
+	private:
+		struct _Cell
+		{
+			std::atomic<size_t> sequence;
+			uint32_t value;
+		};
+		const size_t _mask;
+		std::vector<_Cell> _cells;
+		alignas(64) std::atomic<size_t> _enqueuePosition;
+		alignas(64) std::atomic<size_t> _dequeuePosition;
+
+		BoundedQueue(const BoundedQueue&) = delete;
+		BoundedQueue& operator=(const BoundedQueue&) = delete;
+		BoundedQueue(BoundedQueue&&) = delete;
+		BoundedQueue& operator=(BoundedQueue&&) = delete;
+	public:
+		BoundedQueue(size_t capacity);
+		~BoundedQueue();
+		bool Enqueue(uint32_t value);
+		bool Dequeue(uint32_t& value);
+	};
+}
\ No newline at end of file
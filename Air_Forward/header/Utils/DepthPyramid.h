@@ -0,0 +1,41 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+namespace Utils
+{
+	//Mip chain keeping the farthest depth of every block, a box nearer than nothing it covers is hidden
+	class DepthPyramid
+	{
+	private:
+		struct _Level
+		{
+			uint32_t width;
+			uint32_t height;
+			size_t offset;
+		};
+		std::vector<_Level> _levels;
+		std::vector<float> _depths;
+		glm::mat4 _viewProjection;
+		uint32_t _width;
+		uint32_t _height;
+		bool _valid;
+
+		static void _Reduce(const float* srcDepths, uint32_t srcWidth, uint32_t srcHeight, float* dstDepths, uint32_t dstWidth, uint32_t dstHeight);
+
+		DepthPyramid(const DepthPyramid&) = delete;
+		DepthPyramid& operator=(const DepthPyramid&) = delete;
+		DepthPyramid(DepthPyramid&&) = delete;
+		DepthPyramid& operator=(DepthPyramid&&) = delete;
+	public:
+		//Depths are row major from 0 at the near plane to 1 at the far plane, level 0 already halves them
+		void Build(const float* depths, uint32_t width, uint32_t height, const glm::mat4& viewProjection);
+		void Invalidate();
+		bool Valid() const;
+		uint32_t LevelCount() const;
+		//Projects with the matrix the depths were rendered with, boxes crossing the near plane are never occluded
+		bool IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+		DepthPyramid();
+		~DepthPyramid();
+	};
+}
\ No newline at end of file
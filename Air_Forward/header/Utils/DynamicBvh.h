@@ -0,0 +1,66 @@
+#pragma once
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+namespace Utils
+{
+	//Axis aligned bounding box tree that is refit incrementally, leaves keep enlarged bounds so small moves do not touch the tree
+	class DynamicBvh
+	{
+	public:
+		static constexpr uint32_t NULL_PROXY = UINT32_MAX;
+	private:
+		static constexpr uint32_t NULL_NODE = UINT32_MAX;
+
+		struct _Node
+		{
+			glm::vec3 boundsMin;
+			glm::vec3 boundsMax;
+			void* userData;
+			//Free nodes chain through parent
+			uint32_t parent;
+			uint32_t left;
+			uint32_t right;
+			//Leaves are 0, free nodes are -1
+			int32_t height;
+		};
+		std::vector<_Node> _nodes;
+		uint32_t _root;
+		uint32_t _freeNode;
+		uint32_t _proxyCount;
+		float const _margin;
+		std::vector<std::pair<uint32_t, uint32_t>> _stack;
+		std::vector<std::pair<float, void*>> _rayHits;
+
+		static float _Area(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+		uint32_t _AllocateNode();
+		void _FreeNode(uint32_t nodeIndex);
+		void _InsertLeaf(uint32_t leafIndex);
+		void _RemoveLeaf(uint32_t leafIndex);
+		void _Refit(uint32_t nodeIndex);
+		uint32_t _Balance(uint32_t nodeIndex);
+		void _AddLeaves(uint32_t nodeIndex, std::vector<void*>& results);
+
+		DynamicBvh(const DynamicBvh&) = delete;
+		DynamicBvh& operator=(const DynamicBvh&) = delete;
+		DynamicBvh(DynamicBvh&&) = delete;
+		DynamicBvh& operator=(DynamicBvh&&) = delete;
+	public:
+		DynamicBvh(float margin);
+		~DynamicBvh();
+		uint32_t Insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, void* userData);
+		//Returns true when the bounds left the enlarged leaf bounds and the proxy was reinserted
+		bool Update(uint32_t proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+		void Remove(uint32_t proxy);
+		void* UserData(uint32_t proxy);
+		//Planes point inwards, branches fully inside every plane are taken without further tests, at most 32 planes
+		void Query(const glm::vec4* planes, size_t planeCount, std::vector<void*>& results);
+		void Query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::vector<void*>& results);
+		//Results are ordered by the distance at which the ray enters their bounds
+		void RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<void*>& results);
+		uint32_t ProxyCount();
+		uint32_t Height();
+	};
+}
\ No newline at end of file
@@ -1,16 +1,40 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <vector>
+#include <cstdint>
 namespace Utils
 {
 	class IntersectionChecker
 	{
+	public:
+		//Axis aligned bounds as structure of arrays, so the batch check reads whole simd lanes
+		class BoundsArray
+		{
+		public:
+			std::vector<float> centerXs;
+			std::vector<float> centerYs;
+			std::vector<float> centerZs;
+			std::vector<float> extentXs;
+			std::vector<float> extentYs;
+			std::vector<float> extentZs;
+
+			void Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+			void Clear();
+			size_t Count() const;
+		};
 	private:
 		std::vector<glm::vec4> _intersectPlanes;
+		static void _Check(const BoundsArray& bounds, size_t begin, size_t end, const std::vector<glm::vec4>& planes, std::vector<uint64_t>& visibleMasks);
 	public:
 		void SetIntersectPlanes(glm::vec4* planes, size_t planeCount);
 		bool Check(glm::vec3* vertexes, size_t vertexCount);
 		bool Check(glm::vec3* vertexes, size_t vertexCount, glm::mat4 matrix);
+		//Sets bit i of the masks when bounds i intersects the planes once the matrix is applied, same result as checking its 8 corners
+		void Check(const BoundsArray& bounds, glm::mat4 matrix, std::vector<uint64_t>& visibleMasks);
+		//Same as above over bounds [begin, end), bit 0 of the masks is bounds begin
+		void Check(const BoundsArray& bounds, size_t begin, size_t end, glm::mat4 matrix, std::vector<uint64_t>& visibleMasks);
+		//Planes already in the bounds' space
+		void Check(const BoundsArray& bounds, size_t begin, size_t end, std::vector<uint64_t>& visibleMasks);
 		IntersectionChecker();
 		~IntersectionChecker();
 	};
@@ -0,0 +1,260 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Utils/BoundedQueue.h"
+#include "Utils/WorkStealingDeque.h"
+
+namespace Utils
+{
+	template<typename Context>
+	class JobSystem
+	{
+	public:
+		static const size_t JOB_CAPACITY = 1024;
+		static const size_t JOB_STORAGE_SIZE = 120;
+	private:
+		struct _Job
+		{
+			alignas(std::max_align_t) unsigned char storage[JOB_STORAGE_SIZE];
+			void (*run)(void* storage, Context context);
+		};
+		std::vector<_Job> _jobs;
+		BoundedQueue _freeJobs;
+		BoundedQueue _injectedJobs;
+		std::vector<std::unique_ptr<WorkStealingDeque>> _workerJobs;
+		std::atomic<int64_t> _pendingJobCount;
+		std::atomic<uint32_t> _sleepingWorkerCount;
+		std::atomic<bool> _stopped;
+		std::mutex _sleepMutex;
+		std::condition_variable _sleepVariable;
+
+		static thread_local JobSystem* _currentJobSystem;
+		static thread_local uint32_t _currentWorkerIndex;
+		static thread_local Context* _currentContext;
+
+		uint32_t _AcquireJob();
+		void _RunJob(uint32_t jobIndex, Context context);
+		bool _TakeJob(uint32_t workerIndex, uint32_t& jobIndex);
+		void _Wake();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+	public:
+		JobSystem(uint32_t workerCount);
+		~JobSystem();
+		uint32_t WorkerCount();
+		template<typename F>
+		void Submit(F&& f);
+		void RunWorker(uint32_t workerIndex, Context context);
+		//Idle runs whenever the worker finds no job, while it returns true the worker polls instead of sleeping and does not exit on stop
+		void RunWorker(uint32_t workerIndex, Context context, std::function<bool()> idle);
+		void Stop();
+		bool Stopped();
+	};
+}
+
+template<typename Context>
+thread_local Utils::JobSystem<Context>* Utils::JobSystem<Context>::_currentJobSystem = nullptr;
+template<typename Context>
+thread_local uint32_t Utils::JobSystem<Context>::_currentWorkerIndex = 0;
+template<typename Context>
+thread_local Context* Utils::JobSystem<Context>::_currentContext = nullptr;
+
+template<typename Context>
+Utils::JobSystem<Context>::JobSystem(uint32_t workerCount)
+	: _jobs(JOB_CAPACITY)
+	, _freeJobs(JOB_CAPACITY)
+	, _injectedJobs(JOB_CAPACITY)
+	, _workerJobs()
+	, _pendingJobCount(0)
+	, _sleepingWorkerCount(0)
+	, _stopped(false)
+	, _sleepMutex()
+	, _sleepVariable()
+{
+	for (uint32_t i = 0; i < JOB_CAPACITY; i++)
+	{
+		_freeJobs.Enqueue(i);
+	}
+	for (uint32_t i = 0; i < workerCount; i++)
+	{
+		_workerJobs.emplace_back(new WorkStealingDeque(JOB_CAPACITY));
+	}
+}
+
+template<typename Context>
+Utils::JobSystem<Context>::~JobSystem()
+{
+}
+
+template<typename Context>
+uint32_t Utils::JobSystem<Context>::WorkerCount()
+{
+	return static_cast<uint32_t>(_workerJobs.size());
+}
+
+template<typename Context>
+template<typename F>
+void Utils::JobSystem<Context>::Submit(F&& f)
+{
+	using Function = typename std::decay<F>::type;
+
+	uint32_t jobIndex = _AcquireJob();
+	auto& job = _jobs[jobIndex];
+	if constexpr (sizeof(Function) <= JOB_STORAGE_SIZE && alignof(Function) <= alignof(std::max_align_t))
+	{
+		new (job.storage) Function(std::forward<F>(f));
+		job.run = [](void* storage, Context context) {
+			auto function = std::launder(reinterpret_cast<Function*>(storage));
+			(*function)(context);
+			function->~Function();
+		};
+	}
+	else
+	{
+		//Large jobs fall back to the heap
+		new (job.storage) Function*(new Function(std::forward<F>(f)));
+		job.run = [](void* storage, Context context) {
+			auto function = *std::launder(reinterpret_cast<Function**>(storage));
+			(*function)(context);
+			delete function;
+		};
+	}
+
+	//Workers keep their own jobs, other threads inject
+	if (!(_currentJobSystem == this && _workerJobs[_currentWorkerIndex]->Push(jobIndex)))
+	{
+		while (!_injectedJobs.Enqueue(jobIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+	_pendingJobCount.fetch_add(1);
+	_Wake();
+}
+
+template<typename Context>
+void Utils::JobSystem<Context>::RunWorker(uint32_t workerIndex, Context context)
+{
+	RunWorker(workerIndex, context, nullptr);
+}
+
+template<typename Context>
+void Utils::JobSystem<Context>::RunWorker(uint32_t workerIndex, Context context, std::function<bool()> idle)
+{
+	_currentJobSystem = this;
+	_currentWorkerIndex = workerIndex;
+	_currentContext = &context;
+
+	uint32_t jobIndex = 0;
+	while (true)
+	{
+		if (_TakeJob(workerIndex, jobIndex))
+		{
+			_RunJob(jobIndex, context);
+			continue;
+		}
+
+		bool busy = idle && idle();
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_sleepingWorkerCount.fetch_add(1);
+		if (busy)
+		{
+			_sleepVariable.wait_for(lock, std::chrono::milliseconds(1), [this] { return _pendingJobCount.load() > 0; });
+		}
+		else
+		{
+			_sleepVariable.wait(lock, [this] { return _pendingJobCount.load() > 0 || _stopped.load(); });
+		}
+		_sleepingWorkerCount.fetch_sub(1);
+		if (!busy && _stopped.load() && _pendingJobCount.load() <= 0)
+		{
+			_currentJobSystem = nullptr;
+			_currentContext = nullptr;
+			return;
+		}
+	}
+}
+
+template<typename Context>
+void Utils::JobSystem<Context>::Stop()
+{
+	_stopped.store(true);
+	{
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+	}
+	_sleepVariable.notify_all();
+}
+
+template<typename Context>
+bool Utils::JobSystem<Context>::Stopped()
+{
+	return _stopped.load();
+}
+
+template<typename Context>
+uint32_t Utils::JobSystem<Context>::_AcquireJob()
+{
+	uint32_t jobIndex = 0;
+	while (!_freeJobs.Dequeue(jobIndex))
+	{
+		//Only finished jobs free slots, a worker that waited here could leave every worker waiting
+		uint32_t queuedJobIndex = 0;
+		if (_currentJobSystem == this && _TakeJob(_currentWorkerIndex, queuedJobIndex))
+		{
+			_RunJob(queuedJobIndex, *_currentContext);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	return jobIndex;
+}
+
+template<typename Context>
+void Utils::JobSystem<Context>::_RunJob(uint32_t jobIndex, Context context)
+{
+	_pendingJobCount.fetch_sub(1);
+	auto& job = _jobs[jobIndex];
+	job.run(job.storage, context);
+	_freeJobs.Enqueue(jobIndex);
+}
+
+template<typename Context>
+bool Utils::JobSystem<Context>::_TakeJob(uint32_t workerIndex, uint32_t& jobIndex)
+{
+	if (_workerJobs[workerIndex]->Pop(jobIndex)) return true;
+	if (_injectedJobs.Dequeue(jobIndex)) return true;
+
+	const uint32_t workerCount = WorkerCount();
+	for (uint32_t i = 1; i < workerCount; i++)
+	{
+		if (_workerJobs[(workerIndex + i) % workerCount]->Steal(jobIndex)) return true;
+	}
+	return false;
+}
+
+template<typename Context>
+void Utils::JobSystem<Context>::_Wake()
+{
+	if (_sleepingWorkerCount.load() == 0) return;
+	{
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+	}
+	_sleepVariable.notify_one();
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+namespace Utils
+{
+	class RadixSort
+	{
+	private:
+		std::vector<uint64_t> _keyBuffer;
+		std::vector<uint32_t> _valueBuffer;
+	public:
+		void Sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values);
+		RadixSort();
+		~RadixSort();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Utils/Log.h"
+#include "Utils/JobSystem.h"
+
+namespace Utils
+{
+	template<typename Context>
+	class TaskGraph
+	{
+	private:
+		struct _Node
+		{
+			std::string name;
+			std::function<void(Context)> function;
+			std::vector<uint32_t> dependencies;
+			std::vector<uint32_t> dependents;
+			std::atomic<uint32_t> remainingDependencyCount;
+			std::chrono::steady_clock::time_point startTime;
+			std::chrono::steady_clock::time_point endTime;
+		};
+		std::vector<std::unique_ptr<_Node>> _nodes;
+		JobSystem<Context>* _jobSystem;
+		std::atomic<uint32_t> _remainingNodeCount;
+		std::exception_ptr _exception;
+		std::atomic<bool> _failed;
+		std::mutex _finishMutex;
+		std::condition_variable _finishVariable;
+		std::chrono::steady_clock::time_point _runTime;
+
+		void _Submit(uint32_t nodeIndex);
+		void _Execute(uint32_t nodeIndex, Context context);
+
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+		TaskGraph(TaskGraph&&) = delete;
+		TaskGraph& operator=(TaskGraph&&) = delete;
+	public:
+		TaskGraph();
+		~TaskGraph();
+		//Dependencies must be added before their dependents, so node order is a topological order
+		uint32_t AddNode(std::string name, std::function<void(Context)> function, std::vector<uint32_t> dependencies);
+		uint32_t NodeCount();
+		void Run(JobSystem<Context>& jobSystem);
+		void Wait();
+		std::string CriticalPath();
+	};
+}
+
+template<typename Context>
+Utils::TaskGraph<Context>::TaskGraph()
+	: _nodes()
+	, _jobSystem(nullptr)
+	, _remainingNodeCount(0)
+	, _exception(nullptr)
+	, _failed(false)
+	, _finishMutex()
+	, _finishVariable()
+	, _runTime()
+{
+}
+
+template<typename Context>
+Utils::TaskGraph<Context>::~TaskGraph()
+{
+}
+
+template<typename Context>
+uint32_t Utils::TaskGraph<Context>::AddNode(std::string name, std::function<void(Context)> function, std::vector<uint32_t> dependencies)
+{
+	uint32_t nodeIndex = static_cast<uint32_t>(_nodes.size());
+	for (const auto& dependency : dependencies)
+	{
+		Utils::Log::Exception("Task graph node " + name + " depends on a node that is not added yet.", dependency >= nodeIndex);
+		_nodes[dependency]->dependents.emplace_back(nodeIndex);
+	}
+
+	std::unique_ptr<_Node> node(new _Node());
+	node->name = name;
+	node->function = function;
+	node->dependencies = dependencies;
+	node->remainingDependencyCount.store(0);
+	_nodes.emplace_back(std::move(node));
+	return nodeIndex;
+}
+
+template<typename Context>
+uint32_t Utils::TaskGraph<Context>::NodeCount()
+{
+	return static_cast<uint32_t>(_nodes.size());
+}
+
+template<typename Context>
+void Utils::TaskGraph<Context>::Run(JobSystem<Context>& jobSystem)
+{
+	Utils::Log::Exception("Can not run task graph while it is still running.", _remainingNodeCount.load() != 0);
+
+	_jobSystem = &jobSystem;
+	_exception = nullptr;
+	_failed.store(false);
+	_runTime = std::chrono::steady_clock::now();
+	for (auto& node : _nodes)
+	{
+		node->remainingDependencyCount.store(static_cast<uint32_t>(node->dependencies.size()));
+	}
+	_remainingNodeCount.store(static_cast<uint32_t>(_nodes.size()));
+
+	for (uint32_t i = 0; i < _nodes.size(); i++)
+	{
+		if (_nodes[i]->dependencies.empty())
+		{
+			_Submit(i);
+		}
+	}
+}
+
+template<typename Context>
+void Utils::TaskGraph<Context>::Wait()
+{
+	{
+		std::unique_lock<std::mutex> lock(_finishMutex);
+		_finishVariable.wait(lock, [this] { return _remainingNodeCount.load() == 0; });
+	}
+	if (_exception)
+	{
+		std::rethrow_exception(_exception);
+	}
+}
+
+template<typename Context>
+std::string Utils::TaskGraph<Context>::CriticalPath()
+{
+	if (_nodes.empty()) return "";
+
+	//Walk back from the last finished node through the latest finished dependency
+	uint32_t nodeIndex = 0;
+	for (uint32_t i = 1; i < _nodes.size(); i++)
+	{
+		if (_nodes[i]->endTime > _nodes[nodeIndex]->endTime) nodeIndex = i;
+	}
+	std::vector<uint32_t> path;
+	while (true)
+	{
+		path.emplace_back(nodeIndex);
+		const auto& dependencies = _nodes[nodeIndex]->dependencies;
+		if (dependencies.empty()) break;
+		uint32_t criticalDependency = dependencies[0];
+		for (const auto& dependency : dependencies)
+		{
+			if (_nodes[dependency]->endTime > _nodes[criticalDependency]->endTime) criticalDependency = dependency;
+		}
+		nodeIndex = criticalDependency;
+	}
+
+	auto milliseconds = [](std::chrono::steady_clock::duration duration) {
+		return std::to_string(std::chrono::duration<double, std::milli>(duration).count());
+	};
+	std::string result = "total " + milliseconds(_nodes[path[0]]->endTime - _runTime) + "ms:";
+	for (auto iter = path.rbegin(); iter != path.rend(); ++iter)
+	{
+		const auto& node = _nodes[*iter];
+		result += " " + node->name + "(" + milliseconds(node->endTime - node->startTime) + "ms)";
+		if (iter + 1 != path.rend()) result += " ->";
+	}
+	return result;
+}
+
+template<typename Context>
+void Utils::TaskGraph<Context>::_Submit(uint32_t nodeIndex)
+{
+	_jobSystem->Submit([this, nodeIndex](Context context) {
+		_Execute(nodeIndex, context);
+	});
+}
+
+template<typename Context>
+void Utils::TaskGraph<Context>::_Execute(uint32_t nodeIndex, Context context)
+{
+	auto& node = _nodes[nodeIndex];
+	node->startTime = std::chrono::steady_clock::now();
+	//After a failure the rest of the graph is only counted down, so no node runs on partial results
+	if (!_failed.load())
+	{
+		try
+		{
+			node->function(context);
+		}
+		catch (...)
+		{
+			std::unique_lock<std::mutex> lock(_finishMutex);
+			if (!_exception) _exception = std::current_exception();
+			_failed.store(true);
+		}
+	}
+	node->endTime = std::chrono::steady_clock::now();
+
+	for (const auto& dependent : node->dependents)
+	{
+		if (_nodes[dependent]->remainingDependencyCount.fetch_sub(1) == 1)
+		{
+			_Submit(dependent);
+		}
+	}
+
+	if (_remainingNodeCount.fetch_sub(1) == 1)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_finishMutex);
+		}
+		_finishVariable.notify_all();
+	}
+}
\ No newline at end of file
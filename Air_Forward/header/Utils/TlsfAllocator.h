@@ -0,0 +1,64 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+namespace Utils
+{
+	//Two level segregated fit allocator over an abstract range, it only hands out offsets
+	class TlsfAllocator
+	{
+	public:
+		static constexpr uint64_t GRANULARITY = 16;
+	private:
+		static constexpr uint32_t GRANULARITY_LOG2 = 4;
+		static constexpr uint32_t SL_COUNT_LOG2 = 5;
+		static constexpr uint32_t SL_COUNT = 1 << SL_COUNT_LOG2;
+		static constexpr uint32_t FL_SHIFT = SL_COUNT_LOG2 + GRANULARITY_LOG2;
+		static constexpr uint64_t SMALL_BLOCK_SIZE = 1ull << FL_SHIFT;
+		static constexpr uint32_t FL_COUNT = 64 - FL_SHIFT + 1;
+		static constexpr uint32_t NULL_BLOCK = UINT32_MAX;
+
+		struct _Block
+		{
+			uint64_t offset;
+			uint64_t size;
+			uint32_t prevPhysical;
+			uint32_t nextPhysical;
+			uint32_t prevFree;
+			uint32_t nextFree;
+			bool free;
+		};
+		std::vector<_Block> _blocks;
+		std::vector<uint32_t> _unusedBlocks;
+		uint64_t _flBitmap;
+		std::array<uint32_t, FL_COUNT> _slBitmaps;
+		std::array<std::array<uint32_t, SL_COUNT>, FL_COUNT> _freeBlocks;
+		std::unordered_map<uint64_t, uint32_t> _allocatedBlocks;
+		uint64_t const _size;
+		uint64_t _allocatedSize;
+
+		static void _Mapping(uint64_t size, uint32_t& fl, uint32_t& sl);
+		uint32_t _FindFree(uint64_t size);
+		uint32_t _FindFit(uint64_t size, uint64_t alignment);
+		void _Insert(uint32_t blockIndex);
+		void _Remove(uint32_t blockIndex);
+		uint32_t _NewBlock(uint64_t offset, uint64_t size);
+		void _ReleaseBlock(uint32_t blockIndex);
+
+		TlsfAllocator(const TlsfAllocator&) = delete;
+		TlsfAllocator& operator=(const TlsfAllocator&) = delete;
+		TlsfAllocator(TlsfAllocator&&) = delete;
+		TlsfAllocator& operator=(TlsfAllocator&&) = delete;
+	public:
+		TlsfAllocator(uint64_t size);
+		~TlsfAllocator();
+		//Alignment must be a power of two
+		bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+		void Free(uint64_t offset);
+		uint64_t Size();
+		uint64_t AllocatedSize();
+		uint32_t AllocationCount();
+		uint64_t LargestFreeSize();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+namespace Utils
+{
+	class WorkStealingDeque
+	{
+	private:
+		const int64_t _mask;
+		std::vector<std::atomic<uint32_t>> _values;
+		alignas(64) std::atomic<int64_t> _top;
+		alignas(64) std::atomic<int64_t> _bottom;
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		WorkStealingDeque(WorkStealingDeque&&) = delete;
+		WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+	public:
+		WorkStealingDeque(size_t capacity);
+		~WorkStealingDeque();
+		//Owner only
+		bool Push(uint32_t value);
+		//Owner only
+		bool Pop(uint32_t& value);
+		bool Steal(uint32_t& value);
+	};
+}
\ No newline at end of file
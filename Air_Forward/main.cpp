@@ -12,13 +12,34 @@
 #include "utils/Log.h"
 #include "Logic/Core/Thread.h"
 #include "Logic/Core/Instance.h"
+#include "IO/Core/Instance.h"
+#include "Graphic/Asset/Mesh.h"
+#include "Graphic/Asset/Texture2D.h"
+#include "Graphic/Asset/TextureCube.h"
+#include "Graphic/Asset/Shader.h"
+#include "Graphic/Core/Device.h"
+#include "Graphic/Manager/MemoryManager.h"
+#ifdef _RUN_CULL_BENCHMARK
+#include "Test/CullBenchmark.h"
+#endif
 int main()
 {
+#ifdef _RUN_CULL_BENCHMARK
+	Test::CullBenchmark::Run();
+	return 0;
+#endif
 	Graphic::Core::Thread::Init();
 	Graphic::Core::Thread::Start();
 	Graphic::Core::Thread::WaitForStartFinish();
+	//Move up to 16MB per frame out of chunks less than a quarter used
+	Graphic::Core::Device::MemoryManager().SetDefragmentBudget(16 * 1024 * 1024, 0.25f);
 
 	IO::Core::Thread::Init();
+	//Released assets stay cached until their type exceeds its budget
+	IO::Core::Instance::assetManager.SetBudget(typeid(Graphic::Asset::Mesh), 64 * 1024 * 1024);
+	IO::Core::Instance::assetManager.SetBudget(typeid(Graphic::Asset::Texture2D), 256 * 1024 * 1024);
+	IO::Core::Instance::assetManager.SetBudget(typeid(Graphic::Asset::TextureCube), 128 * 1024 * 1024);
+	IO::Core::Instance::assetManager.SetBudget(typeid(Graphic::Asset::Shader), 4 * 1024 * 1024);
 	IO::Core::Thread::Start();
 	IO::Core::Thread::WaitForStartFinish();
 
@@ -4,6 +4,8 @@
 #include <assimp/postprocess.h>
 #include "Graphic/Command/CommandBuffer.h"
 #include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/StagingBuffer.h"
+#include "IO/Core/Thread.h"
 #include "Graphic/Command/Semaphore.h"
 #include <Utils/Log.h>
 using namespace Utils;
@@ -92,26 +94,40 @@ void Graphic::Asset::Mesh::MeshInstance::_LoadAssetInstance(Graphic::Command::Co
     VkDeviceSize vertexBufferSize = sizeof(VertexData) * _vertices.size();
     VkDeviceSize indexBufferSize = sizeof(uint32_t) * _indices.size();
 
-    Instance::Buffer stageVertexBuffer = Instance::Buffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    stageVertexBuffer.WriteBuffer(_vertices.data(), vertexBufferSize);
-    _vertexBuffer = new Instance::Buffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    //Staging space stays reserved until the batch holding these copies has finished
+    Instance::StagingBuffer& stagingBuffer = IO::Core::Thread::StagingBuffer();
 
-    Instance::Buffer stageIndexBuffer = Instance::Buffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-    stageIndexBuffer.WriteBuffer(_indices.data(), indexBufferSize);
-    _indexBuffer = new Instance::Buffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    Instance::StagingBuffer::Allocation stageVertex = stagingBuffer.Allocate(vertexBufferSize, 16);
+    memcpy(stageVertex.data, _vertices.data(), vertexBufferSize);
+    _vertexBuffer = new Instance::Buffer(vertexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
+    Instance::StagingBuffer::Allocation stageIndex = stagingBuffer.Allocate(indexBufferSize, 16);
+    memcpy(stageIndex.data, _indices.data(), indexBufferSize);
+    _indexBuffer = new Instance::Buffer(indexBufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    transferCommandBuffer->Reset();
-    transferCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-    transferCommandBuffer->CopyBuffer(&stageVertexBuffer, _vertexBuffer);
-    transferCommandBuffer->CopyBuffer(&stageIndexBuffer, _indexBuffer);
-    transferCommandBuffer->EndRecord();
-    transferCommandBuffer->Submit({}, {}, {});
+    transferCommandBuffer->CopyBuffer(stageVertex.buffer, stageVertex.offset, _vertexBuffer, 0, vertexBufferSize);
+    transferCommandBuffer->CopyBuffer(stageIndex.buffer, stageIndex.offset, _indexBuffer, 0, indexBufferSize);
+
+    auto& uploadBatcher = IO::Core::Thread::CurrentUploadBatcher();
+    uploadBatcher.TransferOwnership(_vertexBuffer, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+    uploadBatcher.TransferOwnership(_indexBuffer, VK_ACCESS_INDEX_READ_BIT);
 
     _orientedBoundingBox.BuildBoundingBox(vertexPositions);
 
-    transferCommandBuffer->WaitForFinish();
-    transferCommandBuffer->Reset();
+    //Mesh buffers are only bound by handle while recording, so defragmentation may move them once uploaded
+    uploadBatcher.OnFinish([this]()
+    {
+        _vertexBuffer->EnableMove();
+        _indexBuffer->EnableMove();
+    });
+}
+
+size_t Graphic::Asset::Mesh::MeshInstance::_ResidentSize()
+{
+    size_t size = sizeof(VertexData) * _vertices.capacity() + sizeof(uint32_t) * _indices.capacity();
+    if (_vertexBuffer) size += _vertexBuffer->Size();
+    if (_indexBuffer) size += _indexBuffer->Size();
+    return size;
 }
 
 Graphic::Asset::Mesh::Mesh()
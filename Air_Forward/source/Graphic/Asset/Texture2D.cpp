@@ -2,6 +2,8 @@
 #include "FreeImage/FreeImage.h"
 #include "Graphic/Command/CommandBuffer.h"
 #include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/StagingBuffer.h"
+#include "IO/Core/Thread.h"
 #include <Utils/Log.h>
 using namespace Utils;
 #include "Graphic/Command/Semaphore.h"
@@ -44,7 +46,6 @@ void Graphic::Asset::Texture2D::Texture2DInstance::_LoadAssetInstance(Graphic::C
 
 	Command::Semaphore semaphore = Command::Semaphore();
 
-	transferCommandBuffer->Reset();
 	//Load bitmap
 	{
 		auto p = _settings.imagePath.c_str();
@@ -89,15 +90,16 @@ void Graphic::Asset::Texture2D::Texture2DInstance::_LoadAssetInstance(Graphic::C
 	}
 
 	//Create buffer
-	Instance::Buffer textureStagingBuffer = Instance::Buffer(static_cast<uint64_t>(_extent.width) * _extent.height * 4, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-	textureStagingBuffer.WriteBuffer(_byteData.data(), textureStagingBuffer.Size());
+	Instance::StagingBuffer& stagingBuffer = IO::Core::Thread::StagingBuffer();
+
+	VkDeviceSize textureSize = static_cast<VkDeviceSize>(_extent.width) * _extent.height * 4;
+	Instance::StagingBuffer::Allocation textureStaging = stagingBuffer.Allocate(textureSize, 16);
+	memcpy(textureStaging.data, _byteData.data(), textureSize);
 
 	_textureInfoBuffer = new Instance::Buffer(sizeof(_textureInfo), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	Instance::Buffer infoStagingBuffer = Instance::Buffer(sizeof(_textureInfo), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-	infoStagingBuffer.WriteBuffer(&_textureInfo, infoStagingBuffer.Size());
+	Instance::StagingBuffer::Allocation infoStaging = stagingBuffer.Allocate(sizeof(_textureInfo), 16);
+	memcpy(infoStaging.data, &_textureInfo, sizeof(_textureInfo));
 
-	transferCommandBuffer->Reset();
-	transferCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
 	Command::ImageMemoryBarrier imageTransferStartBarrier = Command::ImageMemoryBarrier(
 		_image,
@@ -111,25 +113,21 @@ void Graphic::Asset::Texture2D::Texture2DInstance::_LoadAssetInstance(Graphic::C
 		{ &imageTransferStartBarrier }
 	);
 
-	transferCommandBuffer->CopyBufferToImage(&textureStagingBuffer, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-	transferCommandBuffer->CopyBuffer(&infoStagingBuffer, _textureInfoBuffer);
+	transferCommandBuffer->CopyBufferToImage(textureStaging.buffer, textureStaging.offset, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	transferCommandBuffer->CopyBuffer(infoStaging.buffer, infoStaging.offset, _textureInfoBuffer, 0, sizeof(_textureInfo));
 
-	Command::ImageMemoryBarrier imageTransferEndBarrier = Command::ImageMemoryBarrier(
-		_image,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-		VK_ACCESS_TRANSFER_WRITE_BIT,
-		0
-	);
-	transferCommandBuffer->AddPipelineBarrier(
-		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-		{ &imageTransferEndBarrier }
-	);
+	//Hands the image over to the render queue family when uploads run on a dedicated transfer queue
+	auto& uploadBatcher = IO::Core::Thread::CurrentUploadBatcher();
+	uploadBatcher.TransferOwnership(_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT);
+	uploadBatcher.TransferOwnership(_textureInfoBuffer, VK_ACCESS_UNIFORM_READ_BIT);
+}
 
-	transferCommandBuffer->EndRecord();
-	transferCommandBuffer->Submit({}, {}, {});
-	transferCommandBuffer->WaitForFinish();
-	transferCommandBuffer->Reset();
+size_t Graphic::Asset::Texture2D::Texture2DInstance::_ResidentSize()
+{
+	size_t size = _byteData.capacity();
+	if (_image) size += _image->Memory_().Size();
+	if (_textureInfoBuffer) size += _textureInfoBuffer->Size();
+	return size;
 }
 
 Graphic::Asset::Texture2D::Texture2D()
@@ -3,6 +3,8 @@
 #include "FreeImage/FreeImage.h"
 #include "Graphic/Command/CommandBuffer.h"
 #include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/StagingBuffer.h"
+#include "IO/Core/Thread.h"
 #include <Utils/Log.h>
 using namespace Utils;
 #include "Graphic/Command/Semaphore.h"
@@ -83,17 +85,14 @@ void Graphic::Asset::TextureCube::TextureCubeInstance::_LoadAssetInstance(Graphi
 	);
 
 	//Create staging buffer
-	Instance::Buffer stagingBuffer = Instance::Buffer(static_cast<uint64_t>(perFaceSize * 6), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-	stagingBuffer.WriteBuffer([perFaceSize, this](void* transferDst) {
-		for (int i = 0; i < 6; i++)
-		{
-			memcpy(static_cast<char*>(transferDst) + i * perFaceSize, _faceByteDatas[i].data(), perFaceSize);
-		}
-	});
+	Instance::StagingBuffer& stagingBuffer = IO::Core::Thread::StagingBuffer();
+	Instance::StagingBuffer::Allocation staging = stagingBuffer.Allocate(static_cast<VkDeviceSize>(perFaceSize * 6), 16);
+	for (int i = 0; i < 6; i++)
+	{
+		memcpy(static_cast<char*>(staging.data) + i * perFaceSize, _faceByteDatas[i].data(), perFaceSize);
+	}
 
 	//Copy buffer to image
-	transferCommandBuffer->Reset();
-	transferCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	Command::ImageMemoryBarrier imageTransferStartBarrier = Command::ImageMemoryBarrier(
 		_image,
 		VK_IMAGE_LAYOUT_UNDEFINED,
@@ -105,23 +104,22 @@ void Graphic::Asset::TextureCube::TextureCubeInstance::_LoadAssetInstance(Graphi
 		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
 		{ &imageTransferStartBarrier }
 	);
-	transferCommandBuffer->CopyBufferToImage(&stagingBuffer, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-	Command::ImageMemoryBarrier imageTransferEndBarrier = Command::ImageMemoryBarrier(
-		_image,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-		VK_ACCESS_TRANSFER_WRITE_BIT,
-		0
-	);
-	transferCommandBuffer->AddPipelineBarrier(
-		VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-		{ &imageTransferEndBarrier }
-	);
+	transferCommandBuffer->CopyBufferToImage(staging.buffer, staging.offset, _image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+	//Hands the image over to the render queue family when uploads run on a dedicated transfer queue
+	auto& uploadBatcher = IO::Core::Thread::CurrentUploadBatcher();
+	uploadBatcher.TransferOwnership(_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT);
+}
 
-	transferCommandBuffer->EndRecord();
-	transferCommandBuffer->Submit({}, {}, {});
-	transferCommandBuffer->WaitForFinish();
-	transferCommandBuffer->Reset();
+size_t Graphic::Asset::TextureCube::TextureCubeInstance::_ResidentSize()
+{
+	size_t size = 0;
+	for (const auto& faceByteData : _faceByteDatas)
+	{
+		size += faceByteData.capacity();
+	}
+	if (_image) size += _image->Memory_().Size();
+	return size;
 }
 
 std::future<Graphic::Asset::TextureCube*> Graphic::Asset::TextureCube::LoadAsync(std::string path)
@@ -14,6 +14,7 @@ Graphic::Asset::Shader::_ShaderInstance::_ShaderInstance(std::string path)
 	: IAssetInstance(path)
 	, _vkPipelineLayout(VK_NULL_HANDLE)
 	, _vkPipeline(VK_NULL_HANDLE)
+	, _spirvSize(0)
 {
 }
 
@@ -48,6 +49,12 @@ void Graphic::Asset::Shader::_ShaderInstance::_LoadAssetInstance(Graphic::Comman
 	_DestroyData(pipelineData);
 }
 
+size_t Graphic::Asset::Shader::_ShaderInstance::_ResidentSize()
+{
+	//Pipeline memory lives in the driver, the spirv size stands in for it
+	return _spirvSize;
+}
+
 void Graphic::Asset::Shader::_ShaderInstance::_ParseShaderData(_PipelineData& pipelineData)
 {
 	std::ifstream input_file(path);
@@ -72,6 +79,7 @@ void Graphic::Asset::Shader::_ShaderInstance::_LoadSpirvs(_PipelineData& pipelin
 		file.read(buffer.data(), fileSize);
 		file.close();
 
+		_spirvSize += fileSize;
 		pipelineData.spirvs.emplace(spirvPath, std::move(buffer));
 	}
 }
@@ -340,6 +348,8 @@ void Graphic::Asset::Shader::_ShaderInstance::_CreateDescriptorLayouts(_Pipeline
 					VkDescriptorSetLayoutBinding layout_binding = {};
 					layout_binding.binding = refl_binding.binding;
 					layout_binding.descriptorType = static_cast<VkDescriptorType>(refl_binding.descriptor_type);
+					if (refl_set.set == FRAME_DATA_SET && layout_binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+					if (refl_set.set == FRAME_DATA_SET && layout_binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER) layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 					layout_binding.descriptorCount = 1;
 					for (uint32_t i_dim = 0; i_dim < refl_binding.array.dims_count; ++i_dim)
 					{
@@ -354,10 +364,22 @@ void Graphic::Asset::Shader::_ShaderInstance::_CreateDescriptorLayouts(_Pipeline
 						SlotLayout newSlotLayout = SlotLayout();
 						newSlotLayout.slotName = refl_binding.name;
 						newSlotLayout.set = refl_set.set;
-						if (refl_binding.descriptor_type == SpvReflectDescriptorType::SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+						if (layout_binding.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC)
+						{
+							newSlotLayout.slotType = SlotType::UNIFORM_BUFFER_DYNAMIC;
+						}
+						else if (layout_binding.descriptorType == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
+						{
+							newSlotLayout.slotType = SlotType::STORAGE_BUFFER_DYNAMIC;
+						}
+						else if (refl_binding.descriptor_type == SpvReflectDescriptorType::SPV_REFLECT_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
 						{
 							newSlotLayout.slotType = SlotType::UNIFORM_BUFFER;
 						}
+						else if (refl_binding.descriptor_type == SpvReflectDescriptorType::SPV_REFLECT_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+						{
+							newSlotLayout.slotType = SlotType::STORAGE_BUFFER;
+						}
 						else if (refl_binding.descriptor_type == SpvReflectDescriptorType::SPV_REFLECT_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && refl_binding.image.dim == SpvDim::SpvDim2D)
 						{
 							newSlotLayout.slotType = SlotType::TEXTURE2D;
@@ -407,6 +429,18 @@ void Graphic::Asset::Shader::_ShaderInstance::_CreateDescriptorLayouts(_Pipeline
 			{
 				slotLayout.slotType = SlotType::UNIFORM_BUFFER;
 			}
+			else if (binding.descriptorType == VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER && setBindingPair.second.size() == 1)
+			{
+				slotLayout.slotType = SlotType::STORAGE_BUFFER;
+			}
+			else if (binding.descriptorType == VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC && setBindingPair.second.size() == 1)
+			{
+				slotLayout.slotType = SlotType::UNIFORM_BUFFER_DYNAMIC;
+			}
+			else if (binding.descriptorType == VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC && setBindingPair.second.size() == 1)
+			{
+				slotLayout.slotType = SlotType::STORAGE_BUFFER_DYNAMIC;
+			}
 			else if (binding.descriptorType == VkDescriptorType::VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && slotLayout.slotType == Asset::SlotType::TEXTURE2D && setBindingPair.second.size() == 1)
 			{
 				slotLayout.slotType = SlotType::TEXTURE2D;
@@ -0,0 +1,32 @@
+#include "Graphic/Command/BufferMemoryBarrier.h"
+#include "Graphic/Instance/Buffer.h"
+
+Graphic::Command::BufferMemoryBarrier::BufferMemoryBarrier(Instance::Buffer* buffer, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags)
+	: BufferMemoryBarrier(buffer, srcAccessFlags, dstAccessFlags, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED)
+{
+}
+
+Graphic::Command::BufferMemoryBarrier::BufferMemoryBarrier(Instance::Buffer* buffer, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex)
+	: _vkBufferMemoryBarriers()
+{
+	_vkBufferMemoryBarriers.resize(1);
+	auto& _vkBufferMemoryBarrier = _vkBufferMemoryBarriers[0];
+
+	_vkBufferMemoryBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	_vkBufferMemoryBarrier.srcAccessMask = srcAccessFlags;
+	_vkBufferMemoryBarrier.dstAccessMask = dstAccessFlags;
+	_vkBufferMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+	_vkBufferMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
+	_vkBufferMemoryBarrier.buffer = buffer->VkBuffer_();
+	_vkBufferMemoryBarrier.offset = buffer->Offset();
+	_vkBufferMemoryBarrier.size = buffer->Size();
+}
+
+Graphic::Command::BufferMemoryBarrier::~BufferMemoryBarrier()
+{
+}
+
+const std::vector<VkBufferMemoryBarrier>& Graphic::Command::BufferMemoryBarrier::VkBufferMemoryBarriers()
+{
+	return _vkBufferMemoryBarriers;
+}
\ No newline at end of file
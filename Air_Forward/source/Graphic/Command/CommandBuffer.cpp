@@ -16,10 +16,12 @@ using namespace Utils;
 #include "Graphic/Command/Semaphore.h"
 #include "Graphic/Instance/SwapchainImage.h"
 #include "Graphic/Command/ImageMemoryBarrier.h"
+#include "Graphic/Command/BufferMemoryBarrier.h"
 Graphic::Command::CommandBuffer::CommandBuffer(std::string name, Graphic::Command::CommandPool* commandPool, VkCommandBufferLevel level)
     : _name(name)
     , _parentCommandPool(commandPool)
     , _commandData()
+    , _bindStatistics()
 {
     VkFenceCreateInfo fenceInfo{};
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
@@ -56,6 +58,29 @@ void Graphic::Command::CommandBuffer::BeginRecord(VkCommandBufferUsageFlags flag
     beginInfo.flags = flag;
 
     vkBeginCommandBuffer(_vkCommandBuffer, &beginInfo);
+
+    //Bound state does not survive a new recording
+    _commandData = _CommandData();
+    _bindStatistics = BindStatistics();
+}
+
+void Graphic::Command::CommandBuffer::BeginRecord(VkCommandBufferUsageFlags flag, Graphic::RenderPass::RenderPassHandle renderPass, uint32_t subpassIndex, Graphic::Instance::FrameBufferHandle frameBuffer)
+{
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass->VkRenderPass_();
+    inheritanceInfo.subpass = subpassIndex;
+    inheritanceInfo.framebuffer = frameBuffer->VkFramebuffer_();
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = flag | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    vkBeginCommandBuffer(_vkCommandBuffer, &beginInfo);
+
+    _commandData = _CommandData();
+    _bindStatistics = BindStatistics();
 }
 
 void Graphic::Command::CommandBuffer::AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, std::vector<ImageMemoryBarrier*> imageMemoryBarriers)
@@ -105,7 +130,51 @@ void Graphic::Command::CommandBuffer::AddPipelineBarrier(VkPipelineStageFlags sr
     );
 }
 
+void Graphic::Command::CommandBuffer::AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask)
+{
+    VkMemoryBarrier memoryBarrier{};
+    memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    memoryBarrier.srcAccessMask = srcAccessMask;
+    memoryBarrier.dstAccessMask = dstAccessMask;
+
+    vkCmdPipelineBarrier(
+        _vkCommandBuffer,
+        srcStageMask, dstStageMask,
+        0,
+        1, &memoryBarrier,
+        0, nullptr,
+        0, nullptr
+    );
+}
+
+void Graphic::Command::CommandBuffer::AddPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, std::vector<ImageMemoryBarrier*> imageMemoryBarriers, std::vector<BufferMemoryBarrier*> bufferMemoryBarriers)
+{
+    std::vector< VkImageMemoryBarrier> vkImageBarriers = std::vector< VkImageMemoryBarrier>();
+    for (const auto& imageMemoryBarrier : imageMemoryBarriers)
+    {
+        vkImageBarriers.insert(vkImageBarriers.end(), imageMemoryBarrier->VkImageMemoryBarriers().begin(), imageMemoryBarrier->VkImageMemoryBarriers().end());
+    }
+    std::vector< VkBufferMemoryBarrier> vkBufferBarriers = std::vector< VkBufferMemoryBarrier>();
+    for (const auto& bufferMemoryBarrier : bufferMemoryBarriers)
+    {
+        vkBufferBarriers.insert(vkBufferBarriers.end(), bufferMemoryBarrier->VkBufferMemoryBarriers().begin(), bufferMemoryBarrier->VkBufferMemoryBarriers().end());
+    }
+    vkCmdPipelineBarrier(
+        _vkCommandBuffer,
+        srcStageMask, dstStageMask,
+        0,
+        0, nullptr,
+        static_cast<uint32_t>(vkBufferBarriers.size()), vkBufferBarriers.data(),
+        static_cast<uint32_t>(vkImageBarriers.size()), vkImageBarriers.data()
+    );
+}
+
 void Graphic::Command::CommandBuffer::CopyBufferToImage(Instance::Buffer* srcBuffer, Instance::Image* dstImage, VkImageLayout dstImageLayout)
+{
+    CopyBufferToImage(srcBuffer, 0, dstImage, dstImageLayout);
+}
+
+void Graphic::Command::CommandBuffer::CopyBufferToImage(Instance::Buffer* srcBuffer, VkDeviceSize srcOffset, Instance::Image* dstImage, VkImageLayout dstImageLayout)
 {
     auto layerCount = dstImage->LayerCount();
     auto layerSize = dstImage->PerLayerSize();
@@ -115,7 +184,7 @@ void Graphic::Command::CommandBuffer::CopyBufferToImage(Instance::Buffer* srcBuf
     {
         auto& region = infos[i];
 
-        region.bufferOffset = layerSize * i;
+        region.bufferOffset = srcOffset + layerSize * i;
         region.bufferRowLength = 0;
         region.bufferImageHeight = 0;
         region.imageSubresource = subresources[i];
@@ -126,6 +195,27 @@ void Graphic::Command::CommandBuffer::CopyBufferToImage(Instance::Buffer* srcBuf
     vkCmdCopyBufferToImage(_vkCommandBuffer, srcBuffer->VkBuffer_(), dstImage->VkImage_(), dstImageLayout, static_cast<uint32_t>(layerCount), infos.data());
 }
 
+void Graphic::Command::CommandBuffer::CopyImageToBuffer(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Buffer* dstBuffer)
+{
+    auto layerCount = srcImage->LayerCount();
+    auto layerSize = srcImage->PerLayerSize();
+    auto subresources = srcImage->VkImageSubresourceLayers_();
+    std::vector< VkBufferImageCopy> infos = std::vector<VkBufferImageCopy>(layerCount);
+    for (uint32_t i = 0; i < layerCount; i++)
+    {
+        auto& region = infos[i];
+
+        region.bufferOffset = dstBuffer->Offset() + layerSize * i;
+        region.bufferRowLength = 0;
+        region.bufferImageHeight = 0;
+        region.imageSubresource = subresources[i];
+        region.imageOffset = { 0, 0, 0 };
+        region.imageExtent = srcImage->VkExtent3D_();
+    }
+
+    vkCmdCopyImageToBuffer(_vkCommandBuffer, srcImage->VkImage_(), srcImageLayout, dstBuffer->VkBuffer_(), static_cast<uint32_t>(layerCount), infos.data());
+}
+
 void Graphic::Command::CommandBuffer::CopyBuffer(Instance::Buffer* srcBuffer, Instance::Buffer* dstBuffer)
 {
     VkBufferCopy copyRegion{};
@@ -183,7 +273,17 @@ void Graphic::Command::CommandBuffer::WaitForFinish()
 
 }
 
+bool Graphic::Command::CommandBuffer::Finished()
+{
+    return vkGetFenceStatus(Core::Device::VkDevice_(), _vkFence) == VK_SUCCESS;
+}
+
 void Graphic::Command::CommandBuffer::BeginRenderPass(Graphic::RenderPass::RenderPassHandle renderPass, Graphic::Instance::FrameBufferHandle frameBuffer, std::vector<VkClearValue> clearValues)
+{
+    BeginRenderPass(renderPass, frameBuffer, clearValues, VK_SUBPASS_CONTENTS_INLINE);
+}
+
+void Graphic::Command::CommandBuffer::BeginRenderPass(Graphic::RenderPass::RenderPassHandle renderPass, Graphic::Instance::FrameBufferHandle frameBuffer, std::vector<VkClearValue> clearValues, VkSubpassContents subpassContents)
 {
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -194,7 +294,19 @@ void Graphic::Command::CommandBuffer::BeginRenderPass(Graphic::RenderPass::Rende
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
 
-    vkCmdBeginRenderPass(_vkCommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(_vkCommandBuffer, &renderPassInfo, subpassContents);
+}
+
+void Graphic::Command::CommandBuffer::ExecuteCommands(std::vector<CommandBuffer*> commandBuffers)
+{
+    if (commandBuffers.empty()) return;
+
+    std::vector<VkCommandBuffer> vkCommandBuffers = std::vector<VkCommandBuffer>(commandBuffers.size());
+    for (size_t i = 0; i < commandBuffers.size(); i++)
+    {
+        vkCommandBuffers[i] = commandBuffers[i]->_vkCommandBuffer;
+    }
+    vkCmdExecuteCommands(_vkCommandBuffer, static_cast<uint32_t>(vkCommandBuffers.size()), vkCommandBuffers.data());
 }
 
 void Graphic::Command::CommandBuffer::EndRenderPass()
@@ -204,22 +316,51 @@ void Graphic::Command::CommandBuffer::EndRenderPass()
 
 void Graphic::Command::CommandBuffer::BindShader(Asset::Shader* shader)
 {
-    vkCmdBindPipeline(_vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader->VkPipeline_());
+    auto pipeline = shader->VkPipeline_();
+    if (pipeline == _commandData.pipeline)
+    {
+        _bindStatistics.pipelineSkipCount++;
+        return;
+    }
+    vkCmdBindPipeline(_vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    _commandData.pipeline = pipeline;
+    _bindStatistics.pipelineBindCount++;
 }
 
 void Graphic::Command::CommandBuffer::BindMesh(Asset::Mesh* mesh)
 {
-    VkBuffer vertexBuffers[] = { mesh->VertexBuffer().VkBuffer_()};
+    auto vertexBuffer = mesh->VertexBuffer().VkBuffer_();
+    auto indexBuffer = mesh->IndexBuffer().VkBuffer_();
+    _commandData.indexCount = static_cast<uint32_t>(mesh->Indices().size());
+    if (vertexBuffer == _commandData.vertexBuffer && indexBuffer == _commandData.indexBuffer)
+    {
+        _bindStatistics.meshSkipCount++;
+        return;
+    }
+    VkBuffer vertexBuffers[] = { vertexBuffer };
     VkDeviceSize offsets[] = { 0 };
     vkCmdBindVertexBuffers(_vkCommandBuffer, 0, 1, vertexBuffers, offsets);
-    _commandData.indexCount = static_cast<uint32_t>(mesh->Indices().size());
-    vkCmdBindIndexBuffer(_vkCommandBuffer, mesh->IndexBuffer().VkBuffer_(), 0, VK_INDEX_TYPE_UINT32);
+    vkCmdBindIndexBuffer(_vkCommandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    _commandData.vertexBuffer = vertexBuffer;
+    _commandData.indexBuffer = indexBuffer;
+    _bindStatistics.meshBindCount++;
 }
 
 void Graphic::Command::CommandBuffer::BindMaterial(Material* material)
 {
     auto sets = material->DescriptorSets();
-    vkCmdBindDescriptorSets(_vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, material->PipelineLayout(), 0, static_cast<uint32_t>(sets.size()), sets.data(), 0, nullptr);
+    auto dynamicOffsets = material->DynamicOffsets();
+    auto pipelineLayout = material->PipelineLayout();
+    if (pipelineLayout == _commandData.pipelineLayout && sets == _commandData.descriptorSets && dynamicOffsets == _commandData.dynamicOffsets)
+    {
+        _bindStatistics.descriptorSetSkipCount++;
+        return;
+    }
+    vkCmdBindDescriptorSets(_vkCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, static_cast<uint32_t>(sets.size()), sets.data(), static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
+    _commandData.pipelineLayout = pipelineLayout;
+    _commandData.descriptorSets = std::move(sets);
+    _commandData.dynamicOffsets = std::move(dynamicOffsets);
+    _bindStatistics.descriptorSetBindCount++;
 }
 
 void Graphic::Command::CommandBuffer::CopyImage(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::Image* dstImage, VkImageLayout dstImageLayout)
@@ -242,9 +383,14 @@ void Graphic::Command::CommandBuffer::CopyImage(Instance::Image* srcImage, VkIma
     vkCmdCopyImage(_vkCommandBuffer, srcImage->VkImage_(), srcImageLayout, dstImage->VkImage_(), dstImageLayout, static_cast<uint32_t>(layerCount), infos.data());
 }
 
-void Graphic::Command::CommandBuffer::Draw()
+void Graphic::Command::CommandBuffer::Draw(uint32_t instanceCount, uint32_t firstInstance)
+{
+    vkCmdDrawIndexed(_vkCommandBuffer, _commandData.indexCount, instanceCount, 0, 0, firstInstance);
+}
+
+const Graphic::Command::CommandBuffer::BindStatistics& Graphic::Command::CommandBuffer::Statistics()
 {
-    vkCmdDrawIndexed(_vkCommandBuffer, _commandData.indexCount, 1, 0, 0, 0);
+    return _bindStatistics;
 }
 
 void Graphic::Command::CommandBuffer::Blit(Instance::Image* srcImage, VkImageLayout srcImageLayout, Instance::SwapchainImage* dstImage, VkImageLayout dstImageLayout)
@@ -35,6 +35,11 @@ VkCommandPool Graphic::Command::CommandPool::VkCommandPool_()
     return _vkCommandPool;
 }
 
+const std::string& Graphic::Command::CommandPool::QueueName()
+{
+    return _queueName;
+}
+
 
 Graphic::Command::CommandBuffer* Graphic::Command::CommandPool::CreateCommandBuffer(std::string name, VkCommandBufferLevel level)
 {
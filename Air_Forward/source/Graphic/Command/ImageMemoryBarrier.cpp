@@ -3,6 +3,11 @@
 #include "Graphic/Instance/SwapchainImage.h"
 
 Graphic::Command::ImageMemoryBarrier::ImageMemoryBarrier(Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags)
+	: ImageMemoryBarrier(image, oldLayout, newLayout, srcAccessFlags, dstAccessFlags, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED)
+{
+}
+
+Graphic::Command::ImageMemoryBarrier::ImageMemoryBarrier(Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccessFlags, VkAccessFlags dstAccessFlags, uint32_t srcQueueFamilyIndex, uint32_t dstQueueFamilyIndex)
 	: _vkImageMemoryBarriers()
 {
 	auto layerCount = image->LayerCount();
@@ -17,8 +22,8 @@ Graphic::Command::ImageMemoryBarrier::ImageMemoryBarrier(Instance::Image* image,
 		_vkImageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		_vkImageMemoryBarrier.oldLayout = oldLayout;
 		_vkImageMemoryBarrier.newLayout = newLayout;
-		_vkImageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-		_vkImageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		_vkImageMemoryBarrier.srcQueueFamilyIndex = srcQueueFamilyIndex;
+		_vkImageMemoryBarrier.dstQueueFamilyIndex = dstQueueFamilyIndex;
 		_vkImageMemoryBarrier.image = image->VkImage_();
 		_vkImageMemoryBarrier.subresourceRange = ranges[i];
 		_vkImageMemoryBarrier.srcAccessMask = srcAccessFlags;
@@ -12,6 +12,7 @@ using namespace Utils;
 VkPhysicalDevice Graphic::Core::Device::_vkPhysicalDevice = VK_NULL_HANDLE;
 VkDevice Graphic::Core::Device::_vkDevice = VK_NULL_HANDLE;
 std::map<std::string, Graphic::Core::Device::Queue*> Graphic::Core::Device::_queues = std::map<std::string, Graphic::Core::Device::Queue*>();
+std::vector<std::string> Graphic::Core::Device::_enabledExtensions = std::vector<std::string>();
 
 Graphic::Manager::MemoryManager* Graphic::Core::Device::_memoryManager = nullptr;
 Graphic::Manager::RenderPassManager* Graphic::Core::Device::_renderPassManager = nullptr;
@@ -23,6 +24,7 @@ Graphic::Core::Device::DeviceCreator::DeviceCreator()
     : desiredPhysicalDeviceType(VkPhysicalDeviceType::VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
     , _desiredPhysicalDeviceFeatures()
     , _desiredDeviceExtensions()
+    , _optionalDeviceExtensions()
     , _desiredQueues()
 #ifdef _USE_GRAPHIC_DEBUG
     , _desiredDeviceLayers()
@@ -41,6 +43,11 @@ void Graphic::Core::Device::DeviceCreator::AddExtension(std::string extensionNam
     _desiredDeviceExtensions.emplace_back(extensionName);
 }
 
+void Graphic::Core::Device::DeviceCreator::AddOptionalExtension(std::string extensionName)
+{
+    _optionalDeviceExtensions.emplace_back(extensionName);
+}
+
 void Graphic::Core::Device::DeviceCreator::SetFeature(std::function<void(VkPhysicalDeviceFeatures&)> const& func)
 {
     func(_desiredPhysicalDeviceFeatures);
@@ -55,7 +62,12 @@ void Graphic::Core::Device::DeviceCreator::AddLayer(std::string layerName)
 
 void Graphic::Core::Device::DeviceCreator::AddQueue(std::string name, VkQueueFlags flag, float prioritie)
 {
-    _desiredQueues.emplace_back(name, flag, prioritie);
+    _desiredQueues.emplace_back(name, flag, prioritie, "");
+}
+
+void Graphic::Core::Device::DeviceCreator::AddQueue(std::string name, VkQueueFlags flag, float prioritie, std::string fallbackQueueName)
+{
+    _desiredQueues.emplace_back(name, flag, prioritie, fallbackQueueName);
 }
 
 void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator)
@@ -120,7 +132,18 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
         vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, queueFamilies.data());
         std::vector<uint32_t> usedCounts = std::vector<uint32_t>(queueFamilyCount, 0);
         std::vector<uint32_t> usedIndexs = std::vector<uint32_t>(creator._desiredQueues.size(), -1);
+        std::vector<uint32_t> sharedQueues = std::vector<uint32_t>(creator._desiredQueues.size(), -1);
+        //Queues that can share another one pick their slots last, so they never take a slot a required queue needs
+        std::vector<uint32_t> queueOrder = std::vector<uint32_t>();
+        for (uint32_t i = 0; i < creator._desiredQueues.size(); i++)
+        {
+            if (creator._desiredQueues[i].fallbackName.empty()) queueOrder.push_back(i);
+        }
         for (uint32_t i = 0; i < creator._desiredQueues.size(); i++)
+        {
+            if (!creator._desiredQueues[i].fallbackName.empty()) queueOrder.push_back(i);
+        }
+        for (const auto& i : queueOrder)
         {
             const auto& desiredQueue = creator._desiredQueues[i];
 
@@ -132,7 +155,7 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
 
                     VkBool32 presentSupport = VK_FALSE;
                     vkGetPhysicalDeviceSurfaceSupportKHR(device, j, Core::Window::_vkSurface, &presentSupport);
-                    if (presentSupport && queueFamilie.queueCount - usedCounts[j] > 1)
+                    if (presentSupport && queueFamilie.queueCount > usedCounts[j])
                     {
                         usedIndexs[i] = j;
                         usedCounts[j] += 1;
@@ -143,15 +166,42 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
             }
             else
             {
+                //Prefer the family with the fewest extra capabilities, so transfer only queues land on the copy engine
+                uint32_t bestFamily = -1;
+                uint32_t bestExtraFlagCount = -1;
                 for (uint32_t j = 0; j < queueFamilies.size(); j++)
                 {
                     const auto& queueFamilie = queueFamilies[j];
-                    if ((desiredQueue.flag & queueFamilie.queueFlags) == desiredQueue.flag && queueFamilie.queueCount - usedCounts[j] > 1)
+                    if ((desiredQueue.flag & queueFamilie.queueFlags) == desiredQueue.flag && queueFamilie.queueCount > usedCounts[j])
                     {
-                        usedIndexs[i] = j;
-                        usedCounts[j] += 1;
-                        ++foundQueueCount;
-                        break;
+                        uint32_t extraFlagCount = 0;
+                        for (VkQueueFlags extraFlags = queueFamilie.queueFlags & ~desiredQueue.flag; extraFlags; extraFlags &= extraFlags - 1)
+                        {
+                            ++extraFlagCount;
+                        }
+                        if (extraFlagCount < bestExtraFlagCount)
+                        {
+                            bestFamily = j;
+                            bestExtraFlagCount = extraFlagCount;
+                        }
+                    }
+                }
+                if (bestFamily != static_cast<uint32_t>(-1))
+                {
+                    usedIndexs[i] = bestFamily;
+                    usedCounts[bestFamily] += 1;
+                    ++foundQueueCount;
+                }
+                else if (!desiredQueue.fallbackName.empty())
+                {
+                    for (uint32_t j = 0; j < creator._desiredQueues.size(); j++)
+                    {
+                        if (creator._desiredQueues[j].name == desiredQueue.fallbackName && usedIndexs[j] != static_cast<uint32_t>(-1))
+                        {
+                            sharedQueues[i] = j;
+                            ++foundQueueCount;
+                            break;
+                        }
                     }
                 }
             }
@@ -164,6 +214,7 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
             std::map<uint32_t, VkDeviceQueueCreateInfo> queueCreateInfoMap = std::map<uint32_t, VkDeviceQueueCreateInfo>();
             for (uint32_t i = 0; i < usedIndexs.size(); i++)
             {
+                if (sharedQueues[i] != static_cast<uint32_t>(-1)) continue;
                 const uint32_t& queueIndex = usedIndexs[i];
                 if (queueCreateInfoMap.count(queueIndex))
                 {
@@ -187,6 +238,7 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
             {
                 queueCreateInfos[i] = info.second;
                 queueCreateInfos[i].pQueuePriorities = queuePrioritieMap[info.first].data();
+                ++i;
             }
         }
 
@@ -199,10 +251,22 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
 
         createInfo.pEnabledFeatures = &creator._desiredPhysicalDeviceFeatures;
 
-        std::vector<const char*> enabledExtensionNames = std::vector<const char*>(creator._desiredDeviceExtensions.size());
+        _enabledExtensions = creator._desiredDeviceExtensions;
+        for (const auto& optionalExtension : creator._optionalDeviceExtensions)
+        {
+            for (const auto& availableExtension : availableExtensions)
+            {
+                if (strcmp(availableExtension.extensionName, optionalExtension.c_str()) == 0)
+                {
+                    _enabledExtensions.emplace_back(optionalExtension);
+                    break;
+                }
+            }
+        }
+        std::vector<const char*> enabledExtensionNames = std::vector<const char*>(_enabledExtensions.size());
         for (uint32_t i = 0; i < enabledExtensionNames.size(); i++)
         {
-            enabledExtensionNames[i] = creator._desiredDeviceExtensions[i].c_str();
+            enabledExtensionNames[i] = _enabledExtensions[i].c_str();
         }
 
         createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensionNames.size());
@@ -225,12 +289,19 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
         usedCounts = std::vector<uint32_t>(queueFamilyCount, 0);
         for (uint32_t i = 0; i < usedIndexs.size(); i++)
         {
+            if (sharedQueues[i] != static_cast<uint32_t>(-1)) continue;
             const uint32_t& queueIndex = usedIndexs[i];
             std::string name = std::string(creator._desiredQueues[i].name);
             Queue* gq = new Queue(name, queueIndex, VK_NULL_HANDLE);
             vkGetDeviceQueue(_vkDevice, queueIndex, usedCounts[queueIndex]++, &(gq->queue));
             _queues.emplace(name, gq);
         }
+        //Shared queues are the same object, so submits stay serialized by one mutex
+        for (uint32_t i = 0; i < sharedQueues.size(); i++)
+        {
+            if (sharedQueues[i] == static_cast<uint32_t>(-1)) continue;
+            _queues.emplace(creator._desiredQueues[i].name, _queues[creator._desiredQueues[sharedQueues[i]].name]);
+        }
 
         _CreateManager(creator);
 
@@ -243,6 +314,15 @@ void Graphic::Core::Device::Create(Graphic::Core::Device::DeviceCreator& creator
 
 }
 
+bool Graphic::Core::Device::ExtensionEnabled(std::string extensionName)
+{
+    for (const auto& enabledExtension : _enabledExtensions)
+    {
+        if (enabledExtension == extensionName) return true;
+    }
+    return false;
+}
+
 void Graphic::Core::Device::_AddWindowExtension(Graphic::Core::Device::DeviceCreator& creator)
 {
     creator.AddExtension(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
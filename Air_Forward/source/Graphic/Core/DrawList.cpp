@@ -0,0 +1,99 @@
+#include "Graphic/Core/DrawList.h"
+#include "Graphic/Manager/MatrixDataManager.h"
+#include "Utils/Log.h"
+#include <cstring>
+
+Graphic::Core::DrawList::DrawList(uint32_t passIndex, SortMode sortMode)
+	: _passKey(static_cast<uint64_t>(passIndex) << (DEPTH_KEY_BITS + STATE_KEY_BITS))
+	, _sortMode(sortMode)
+	, _sortKeys()
+	, _indexes()
+	, _rendererProxies()
+	, _drawBatches()
+	, _radixSort()
+{
+	Utils::Log::Exception("Graphic::Core::DrawList pass index out of range.", passIndex >= (1u << PASS_KEY_BITS));
+}
+
+Graphic::Core::DrawList::~DrawList()
+{
+}
+
+uint64_t Graphic::Core::DrawList::_DepthKey(float viewDepth)
+{
+	//Map float to an order preserving unsigned integer
+	uint32_t bits;
+	std::memcpy(&bits, &viewDepth, sizeof(uint32_t));
+	bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	return bits >> (32 - DEPTH_KEY_BITS);
+}
+
+uint64_t Graphic::Core::DrawList::SortKey(const FrameSnapshot::RendererProxy* rendererProxy, float viewDepth) const
+{
+	const uint64_t stateMask = (1ull << STATE_KEY_BITS) - 1;
+	const uint64_t depthMask = (1ull << DEPTH_KEY_BITS) - 1;
+	uint64_t stateKey = rendererProxy->sortKey & stateMask;
+	uint64_t depthKey = _DepthKey(viewDepth);
+	if (_sortMode == SortMode::STATE_MAJOR)
+	{
+		//Nearer draws first inside the same state
+		return _passKey | (stateKey << DEPTH_KEY_BITS) | (~depthKey & depthMask);
+	}
+	else
+	{
+		return _passKey | (depthKey << STATE_KEY_BITS) | stateKey;
+	}
+}
+
+void Graphic::Core::DrawList::Add(FrameSnapshot::RendererProxy* rendererProxy, uint64_t sortKey)
+{
+	_sortKeys.emplace_back(sortKey);
+	_indexes.emplace_back(static_cast<uint32_t>(_rendererProxies.size()));
+	_rendererProxies.emplace_back(rendererProxy);
+}
+
+void Graphic::Core::DrawList::Build(Manager::MatrixDataManager& matrixDataManager)
+{
+	_radixSort.Sort(_sortKeys, _indexes);
+
+	//Only state major lists keep equal mesh and material adjacent
+	const bool enableInstancing = _sortMode == SortMode::STATE_MAJOR;
+	for (const auto& index : _indexes)
+	{
+		auto rendererProxy = _rendererProxies[index];
+		uint32_t instanceIndex = matrixDataManager.AddInstanceData(rendererProxy->modelMatrix);
+		if (enableInstancing && !_drawBatches.empty())
+		{
+			auto& lastDrawBatch = _drawBatches.back();
+			if (lastDrawBatch.rendererProxy->mesh == rendererProxy->mesh && lastDrawBatch.rendererProxy->material == rendererProxy->material)
+			{
+				lastDrawBatch.instanceCount++;
+				continue;
+			}
+		}
+		_drawBatches.push_back({ rendererProxy, instanceIndex, 1 });
+	}
+}
+
+void Graphic::Core::DrawList::Clear()
+{
+	_sortKeys.clear();
+	_indexes.clear();
+	_rendererProxies.clear();
+	_drawBatches.clear();
+}
+
+size_t Graphic::Core::DrawList::Size()
+{
+	return _indexes.size();
+}
+
+size_t Graphic::Core::DrawList::BatchCount()
+{
+	return _drawBatches.size();
+}
+
+const Graphic::Core::DrawList::DrawBatch& Graphic::Core::DrawList::Batch(size_t index)
+{
+	return _drawBatches[index];
+}
\ No newline at end of file
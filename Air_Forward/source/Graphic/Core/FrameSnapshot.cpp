@@ -0,0 +1,93 @@
+#include "Graphic/Core/FrameSnapshot.h"
+#include "Logic/Component/Light/SkyBox.h"
+#include "Logic/Component/Renderer/Renderer.h"
+#include "Graphic/Asset/Mesh.h"
+#include "Graphic/Asset/Shader.h"
+#include "Graphic/Instance/Buffer.h"
+#include "Graphic/Material.h"
+#include <functional>
+#include <glm/glm.hpp>
+
+void Graphic::Core::FrameSnapshot::AddLight(std::vector<Logic::Component::Component*>& lightComponents)
+{
+	for (const auto& lightComponent : lightComponents)
+	{
+		auto light = static_cast<Logic::Component::Light::Light*>(lightComponent);
+
+		LightSnapshot lightSnapshot{};
+		lightSnapshot.lightType = light->lightType;
+		lightSnapshot.lightData = light->GetLightData();
+		lightSnapshot.textureCube = light->lightType == Logic::Component::Light::Light::LightType::SKY_BOX ? static_cast<Logic::Component::Light::SkyBox*>(light)->TextureCube() : nullptr;
+		lights.emplace_back(lightSnapshot);
+	}
+}
+
+void Graphic::Core::FrameSnapshot::AddCamera(std::vector<Logic::Component::Component*>& cameraComponents)
+{
+	for (const auto& cameraComponent : cameraComponents)
+	{
+		auto camera = static_cast<Logic::Component::Camera::Camera*>(cameraComponent);
+
+		CameraSnapshot cameraSnapshot{};
+		cameraSnapshot.camera = camera;
+		cameraSnapshot.viewMatrix = camera->ViewMatrix();
+		cameraSnapshot.projectionMatrix = camera->ProjectionMatrix();
+		cameraSnapshot.worldClipPlanes = camera->WorldClipPlanes();
+		cameraSnapshot.cameraData = camera->GetCameraData();
+		cameras.emplace_back(cameraSnapshot);
+	}
+}
+
+void Graphic::Core::FrameSnapshot::AddRenderer(std::vector<Logic::Component::Component*>& rendererComponents)
+{
+	for (const auto& rendererComponent : rendererComponents)
+	{
+		auto renderer = static_cast<Logic::Component::Renderer::Renderer*>(rendererComponent);
+
+		if (!(renderer->material && renderer->mesh)) continue;
+
+		RendererProxy rendererProxy{};
+		rendererProxy.modelMatrix = renderer->ModelMatrix();
+		rendererProxy.mesh = renderer->mesh;
+		rendererProxy.material = renderer->material;
+		rendererProxy.enableFrustumCulling = renderer->enableFrustumCulling;
+		rendererProxy.sortKey = _StateKey(renderer->mesh, renderer->material);
+
+		//Bounds are cached by the renderer and only rebuilt when its transform changes
+		rendererProxy.boundsMin = renderer->BoundsMin();
+		rendererProxy.boundsMax = renderer->BoundsMax();
+
+		renderers.emplace_back(rendererProxy);
+		rendererBounds.Add(rendererProxy.boundsMin, rendererProxy.boundsMax);
+	}
+}
+
+uint64_t Graphic::Core::FrameSnapshot::_StateKey(Asset::Mesh* mesh, Material* material)
+{
+	const uint64_t mask = (1ull << 12) - 1;
+	uint64_t pipelineKey = std::hash<uint64_t>()((uint64_t)material->Shader().VkPipeline_()) & mask;
+	uint64_t materialKey = std::hash<uint64_t>()(reinterpret_cast<uintptr_t>(material)) & mask;
+	//Defragmentation swaps vertex buffer handles while this snapshot fills, the mesh itself stays put
+	uint64_t meshKey = std::hash<uint64_t>()(reinterpret_cast<uintptr_t>(mesh)) & mask;
+	return (pipelineKey << 24) | (materialKey << 12) | meshKey;
+}
+
+void Graphic::Core::FrameSnapshot::Clear()
+{
+	lights.clear();
+	cameras.clear();
+	renderers.clear();
+	rendererBounds.Clear();
+}
+
+Graphic::Core::FrameSnapshot::FrameSnapshot()
+	: lights()
+	, cameras()
+	, renderers()
+	, rendererBounds()
+{
+}
+
+Graphic::Core::FrameSnapshot::~FrameSnapshot()
+{
+}
\ No newline at end of file
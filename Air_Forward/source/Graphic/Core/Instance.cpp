@@ -1,5 +1,6 @@
 #include "Graphic/Core/Instance.h"
 #include "Graphic/Core/Window.h"
+#include "Graphic/Core/FrameSnapshot.h"
 #include <Utils/Log.h>
 using namespace Utils;
 #include <GLFW/glfw3.h>
@@ -9,12 +10,16 @@ VkInstance Graphic::Core::Instance::_vkInstance = VK_NULL_HANDLE;
 VkDebugUtilsMessengerEXT Graphic::Core::Instance::_debugMessenger = VK_NULL_HANDLE;
 Graphic::Command::CommandPool* Graphic::Core::Instance::presentCommandPool = nullptr;
 Graphic::Command::CommandBuffer* Graphic::Core::Instance::presentCommandBuffer = nullptr;
-Utils::Condition* Graphic::Core::Instance::_renderStartCondition = new Utils::Condition();
-Utils::Condition* Graphic::Core::Instance::_renderEndCondition = new Utils::Condition();
 Graphic::Manager::LightManager* Graphic::Core::Instance::lightManager  = nullptr;
-std::vector<Logic::Component::Component*> Graphic::Core::Instance::_lights = std::vector<Logic::Component::Component*>();
-std::vector<Logic::Component::Component*> Graphic::Core::Instance::_cameras = std::vector<Logic::Component::Component*>();
-std::vector<Logic::Component::Component*> Graphic::Core::Instance::_renderers = std::vector<Logic::Component::Component*>();
+Graphic::Manager::MatrixDataManager* Graphic::Core::Instance::matrixDataManager = nullptr;
+Graphic::Manager::OcclusionManager* Graphic::Core::Instance::occlusionManager = nullptr;
+std::vector<Graphic::Core::FrameSnapshot*> Graphic::Core::Instance::_frameSnapshots = std::vector<Graphic::Core::FrameSnapshot*>();
+uint32_t Graphic::Core::Instance::_logicFrameIndex = 0;
+uint32_t Graphic::Core::Instance::_renderFrameIndex = 0;
+uint32_t Graphic::Core::Instance::_submittedFrameCount = 0;
+uint32_t Graphic::Core::Instance::_pendingFrameCount = 0;
+std::mutex Graphic::Core::Instance::_frameMutex = std::mutex();
+std::condition_variable Graphic::Core::Instance::_frameVariable = std::condition_variable();
 
 Graphic::Core::Instance::InstanceCreator::InstanceCreator()
 	: applicationName("Vulkan Application")
@@ -22,6 +27,7 @@ Graphic::Core::Instance::InstanceCreator::InstanceCreator()
 	, engineName("No Engine")
 	, engineVersion(VK_MAKE_VERSION(1, 0, 0))
 	, apiVersion(VK_API_VERSION_1_0)
+	, framesInFlight(2)
 #ifdef _USE_GRAPHIC_DEBUG
 	, messageSeverity(VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
 	, messageType(VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT)
@@ -120,6 +126,23 @@ void Graphic::Core::Instance::Create(InstanceCreator& creator)
 #endif
 
 	Graphic::Core::Window::_CreateSurface();
+
+	_CreateFrameSnapshots(creator);
+}
+
+void Graphic::Core::Instance::_CreateFrameSnapshots(InstanceCreator& creator)
+{
+	Log::Exception("Frames in flight should between 1 and 3.", creator.framesInFlight < 1 || creator.framesInFlight > 3);
+
+	_frameSnapshots.resize(creator.framesInFlight);
+	for (auto& frameSnapshot : _frameSnapshots)
+	{
+		frameSnapshot = new FrameSnapshot();
+	}
+	_logicFrameIndex = 0;
+	_renderFrameIndex = 0;
+	_submittedFrameCount = 0;
+	_pendingFrameCount = 0;
 }
 
 void Graphic::Core::Instance::_AddWindowExtension(InstanceCreator& creator)
@@ -175,27 +198,58 @@ void Graphic::Core::Instance::_CreateDebugMessenger(InstanceCreator& creator)
 }
 #endif
 
-Utils::Condition& Graphic::Core::Instance::RenderStartCondition()
+uint32_t Graphic::Core::Instance::FramesInFlight()
 {
-	return *_renderStartCondition;
+	return static_cast<uint32_t>(_frameSnapshots.size());
 }
 
-Utils::Condition& Graphic::Core::Instance::RenderEndCondition()
+void Graphic::Core::Instance::AcquireLogicFrame()
 {
-	return *_renderEndCondition;
+	std::unique_lock<std::mutex> lock(_frameMutex);
+	_frameVariable.wait(lock, [] {return _pendingFrameCount < _frameSnapshots.size(); });
 }
 
 void Graphic::Core::Instance::AddLight(std::vector<Logic::Component::Component*>& lights)
 {
-	_lights.insert(_lights.end(), lights.begin(), lights.end());
+	_frameSnapshots[_logicFrameIndex]->AddLight(lights);
 }
 
 void Graphic::Core::Instance::AddCamera(std::vector<Logic::Component::Component*>& cameras)
 {
-	_cameras.insert(_cameras.end(), cameras.begin(), cameras.end());
+	_frameSnapshots[_logicFrameIndex]->AddCamera(cameras);
 }
 
 void Graphic::Core::Instance::AddRenderer(std::vector<Logic::Component::Component*>& renderers)
 {
-	_renderers.insert(_renderers.end(), renderers.begin(), renderers.end());
+	_frameSnapshots[_logicFrameIndex]->AddRenderer(renderers);
+}
+
+void Graphic::Core::Instance::SubmitLogicFrame()
+{
+	{
+		std::unique_lock<std::mutex> lock(_frameMutex);
+		_logicFrameIndex = (_logicFrameIndex + 1) % _frameSnapshots.size();
+		++_submittedFrameCount;
+		++_pendingFrameCount;
+	}
+	_frameVariable.notify_all();
+}
+
+Graphic::Core::FrameSnapshot* Graphic::Core::Instance::_AcquireRenderFrame()
+{
+	std::unique_lock<std::mutex> lock(_frameMutex);
+	_frameVariable.wait(lock, [] {return _submittedFrameCount > 0; });
+	--_submittedFrameCount;
+	return _frameSnapshots[_renderFrameIndex];
+}
+
+void Graphic::Core::Instance::_ReleaseRenderFrame()
+{
+	{
+		std::unique_lock<std::mutex> lock(_frameMutex);
+		_frameSnapshots[_renderFrameIndex]->Clear();
+		_renderFrameIndex = (_renderFrameIndex + 1) % _frameSnapshots.size();
+		--_pendingFrameCount;
+	}
+	_frameVariable.notify_all();
 }
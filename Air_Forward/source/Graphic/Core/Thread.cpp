@@ -1,6 +1,8 @@
 #include "Graphic/Core/Thread.h"
 #include "Graphic/Core/Device.h"
 #include "Graphic/Core/Instance.h"
+#include "Graphic/Core/FrameSnapshot.h"
+#include "Graphic/Core/DrawList.h"
 #include "Graphic/Core/Window.h"
 #include "Graphic/Manager/RenderPassManager.h"
 #include "Graphic/RenderPass/RenderPass.h"
@@ -27,9 +29,15 @@
 #include "Logic/Component/Renderer/Renderer.h"
 #include "Logic/Component/Renderer/BackgroundRenderer.h"
 #include "Utils/IntersectionChecker.h"
+#include "Utils/TaskGraph.h"
 #include "Logic/Object/GameObject.h"
 #include <map>
+#include <array>
+#include <algorithm>
+#include <chrono>
 #include "Graphic/Manager/LightManager.h"
+#include "Graphic/Manager/MatrixDataManager.h"
+#include "Graphic/Manager/OcclusionManager.h"
 #include "Logic/Component/Light/SkyBox.h"
 #include "Graphic/RenderPass/OpaqueRenderPass.h"
 #include "Graphic/RenderPass/BackgroundRenderPass.h"
@@ -40,9 +48,7 @@ Graphic::Core::Thread::RenderThread Graphic::Core::Thread::_renderThread = Graph
 Graphic::Core::Thread::RenderThread::RenderThread()
 	: ThreadBase()
 	, _stopped(true)
-	, _tasks()
-	, _queueMutex()
-	, _queueVariable()
+	, _jobSystem(4)
 {
 }
 
@@ -53,10 +59,10 @@ Graphic::Core::Thread::RenderThread::~RenderThread()
 
 void Graphic::Core::Thread::RenderThread::Init()
 {
-	subRenderThreads.emplace_back(new SubRenderThread(this));
-	subRenderThreads.emplace_back(new SubRenderThread(this));
-	subRenderThreads.emplace_back(new SubRenderThread(this));
-	subRenderThreads.emplace_back(new SubRenderThread(this));
+	for (uint32_t i = 0; i < _jobSystem.WorkerCount(); i++)
+	{
+		subRenderThreads.emplace_back(new SubRenderThread(this, i));
+	}
 
 	for (const auto& subRenderThread : subRenderThreads)
 	{
@@ -77,6 +83,8 @@ void Graphic::Core::Thread::RenderThread::OnThreadStart()
 	}
 	{
 		Core::Instance::InstanceCreator instanceCreator = Core::Instance::InstanceCreator();
+		//Memory budget queries need vkGetPhysicalDeviceMemoryProperties2
+		instanceCreator.apiVersion = VK_API_VERSION_1_1;
 		Core::Instance::Create(instanceCreator);
 	}
 	{
@@ -85,7 +93,9 @@ void Graphic::Core::Thread::RenderThread::OnThreadStart()
 			{
 				features.geometryShader = VK_TRUE;
 			});
-		deviceCreator.AddQueue("TransferQueue", VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT, 1.0);
+		deviceCreator.AddOptionalExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		//Asset uploads run on a dedicated transfer family when the device has one, and share the render queue when no slot is left
+		deviceCreator.AddQueue("TransferQueue", VkQueueFlagBits::VK_QUEUE_TRANSFER_BIT, 1.0, "RenderQueue");
 		deviceCreator.AddQueue("RenderQueue", VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT, 1.0);
 		deviceCreator.AddQueue("ComputeQueue", VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT, 1.0);
 		deviceCreator.AddQueue("PresentQueue", VkQueueFlagBits::VK_QUEUE_GRAPHICS_BIT, 1.0);
@@ -96,6 +106,8 @@ void Graphic::Core::Thread::RenderThread::OnThreadStart()
 	Core::Instance::presentCommandPool = new Graphic::Command::CommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, "PresentQueue");
 	Core::Instance::presentCommandBuffer = Core::Instance::presentCommandPool->CreateCommandBuffer("PresentCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 	Core::Instance::lightManager = new Manager::LightManager();
+	Core::Instance::matrixDataManager = new Manager::MatrixDataManager();
+	Core::Instance::occlusionManager = new Manager::OcclusionManager();
 
 	Core::Device::RenderPassManager().AddRenderPass(new Graphic::RenderPass::OpaqueRenderPass());
 	Core::Device::RenderPassManager().AddRenderPass(new Graphic::RenderPass::BackgroundRenderPass());
@@ -103,14 +115,14 @@ void Graphic::Core::Thread::RenderThread::OnThreadStart()
 
 	{
 		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::UNIFORM_BUFFER, { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER }, 10);
+		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::STORAGE_BUFFER, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER }, 10);
+		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::UNIFORM_BUFFER_DYNAMIC, { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC }, 10);
+		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::STORAGE_BUFFER_DYNAMIC, { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC }, 10);
 		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::TEXTURE_CUBE, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER }, 10);
 		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::TEXTURE2D, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER }, 10);
 		Core::Device::DescriptorSetManager().AddDescriptorSetPool(Asset::SlotType::TEXTURE2D_WITH_INFO, { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER }, 10);
 	}
 
-	Core::Instance::_cameras.clear();
-	Core::Instance::_renderers.clear();
-
 	for (const auto& subRenderThread : subRenderThreads)
 	{
 		subRenderThread->Start();
@@ -126,107 +138,161 @@ void Graphic::Core::Thread::RenderThread::OnRun()
 	auto & presentCommandBuffer = Core::Instance::presentCommandBuffer;
 
 
-	Utils::IntersectionChecker intersectionChecker = Utils::IntersectionChecker();
-	while (!_stopped && !glfwWindowShouldClose(Core::Window::GLFWwindow_()))
+	std::map<std::string, DrawList*> drawLists = std::map<std::string, DrawList*>();
 	{
-		Instance::RenderStartCondition().Wait();
-		Utils::Log::Message("Graphic::Core::Thread::RenderThread wait render start.");
-		Utils::Log::Message("Graphic::Core::Thread::RenderThread start with " + std::to_string(Instance::_lights.size()) + " light and " + std::to_string(Instance::_cameras.size()) + " camera and " + std::to_string(Instance::_renderers.size()) + " renderer.");
-		
-		std::map<std::string, std::future<Graphic::Command::CommandBuffer*>> commandBufferTaskMap = std::map<std::string, std::future<Graphic::Command::CommandBuffer*>>();
-		std::map<std::string, std::multimap<float, Logic::Component::Renderer::Renderer*>> rendererDistenceMaps = std::map<std::string, std::multimap<float, Logic::Component::Renderer::Renderer*>>();
-		for (auto& renderPassPair : Core::Device::RenderPassManager()._renderPasss)
+		uint32_t passIndex = 0;
+		for (const auto& renderIndexPair : Core::Device::RenderPassManager()._renderIndexMap)
 		{
-			rendererDistenceMaps[renderPassPair.first] = {};
+			auto renderPass = Core::Device::RenderPassManager()._renderPasss[renderIndexPair.second];
+			drawLists[renderIndexPair.second] = new DrawList(passIndex++, renderPass->DrawListSortMode());
 		}
+	}
 
-		glfwPollEvents();
-
-		//Lights
-		auto lightCopyTask = AddTask([](Command::CommandPool* commandPool)->Command::CommandBuffer* {
-			Core::Instance::lightManager->SetLightData(Core::Instance::_lights);
-			auto commandBuffer = commandPool->CreateCommandBuffer("LightCopyCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-			Core::Instance::lightManager->CopyLightData(commandBuffer);
-			commandPool->DestoryCommandBuffer("LightCopyCommandBuffer");
-			return nullptr;
-		});
-
-		//Camera
-		auto camera = dynamic_cast<Logic::Component::Camera::Camera*>(Instance::_cameras[0]);
-		glm::mat4 viewMatrix = camera->ViewMatrix();
-		glm::mat4 projectionMatrix = camera->ProjectionMatrix();
-		glm::mat4 vpMatrix = projectionMatrix * viewMatrix;
-
-		auto cameraCopyTask = AddTask([](Command::CommandPool* commandPool, Logic::Component::Camera::Camera* camera)->Command::CommandBuffer* {
-			camera->SetCameraData();
-			auto commandBuffer = commandPool->CreateCommandBuffer("CameraCopyCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
-			camera->CopyCameraData(commandBuffer);
-			commandPool->DestoryCommandBuffer("CameraCopyCommandBuffer");
-			return nullptr;
-			}, camera);
-
-		//Wait task
-		lightCopyTask.get();
-		cameraCopyTask.get();
-
-		//Classify renderers
-		auto clipPlanes = camera->ClipPlanes();
-		intersectionChecker.SetIntersectPlanes(clipPlanes.data(), clipPlanes.size());
-		for (auto& rendererComponent : Instance::_renderers)
+	//Frame task graph
+	FrameSnapshot* frameSnapshot = nullptr;
+	uint32_t imageIndex = 0;
+	Utils::TaskGraph<Command::CommandPool*> frameGraph = Utils::TaskGraph<Command::CommandPool*>();
+
+	//Light and camera uploads are recorded into the frame's first submission, later passes are ordered behind it on the same queue
+	Command::CommandPool* frameUploadCommandPool = new Command::CommandPool(VkCommandPoolCreateFlagBits::VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, "RenderQueue");
+	Command::CommandBuffer* frameUploadCommandBuffer = frameUploadCommandPool->CreateCommandBuffer("FrameUploadCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+	uint32_t frameUploadNode = frameGraph.AddNode("FrameUpload", [&frameSnapshot, frameUploadCommandBuffer](Command::CommandPool* commandPool) {
+		auto& cameraSnapshot = frameSnapshot->cameras[0];
+		Core::Instance::lightManager->SetLightData(frameSnapshot->lights);
+
+		frameUploadCommandBuffer->Reset();
+		frameUploadCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+		Core::Instance::lightManager->CopyLightData(frameUploadCommandBuffer);
+		cameraSnapshot.camera->CopyCameraData(frameUploadCommandBuffer, cameraSnapshot.cameraData);
+		frameUploadCommandBuffer->AddPipelineBarrier(
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_UNIFORM_READ_BIT
+		);
+		frameUploadCommandBuffer->EndRecord();
+		frameUploadCommandBuffer->Submit({}, {}, {});
+	}, {});
+
+	//Last frame's depth is on host by now, this frame's matrix goes with the copy the opaque pass records
+	uint32_t depthPyramidNode = frameGraph.AddNode("DepthPyramid", [&frameSnapshot](Command::CommandPool* commandPool) {
+		auto& cameraSnapshot = frameSnapshot->cameras[0];
+		Instance::occlusionManager->BuildDepthPyramid(cameraSnapshot.projectionMatrix * cameraSnapshot.viewMatrix);
+	}, {});
+
+	//Visibility and sort keys are built in one chunk per worker, no chunk touches materials or draw lists
+	struct CullChunk
+	{
+		struct VisibleRenderer
 		{
-			auto renderer = dynamic_cast<Logic::Component::Renderer::Renderer*>(rendererComponent);
-
-			if (!(renderer->material && renderer->mesh)) continue;
-
-			glm::mat4 modelMatrix = renderer->ModelMatrix();
-			glm::mat4 mvMatrix = viewMatrix * modelMatrix;
-			glm::mat4 mvpMatrix = projectionMatrix * viewMatrix * modelMatrix;
-
-			//Frustum Culling
-			auto obbCenter = renderer->mesh->OrientedBoundingBox().Center();
-			auto obbMvCenter = mvMatrix * glm::vec4(obbCenter, 1.0f);
-			auto obbBoundry = renderer->mesh->OrientedBoundingBox().BoundryVertexes();
-			if (!renderer->enableFrustumCulling || intersectionChecker.Check(obbBoundry.data(), obbBoundry.size(), mvMatrix))
+			FrameSnapshot::RendererProxy* rendererProxy;
+			DrawList* drawList;
+			uint64_t sortKey;
+		};
+		Utils::IntersectionChecker intersectionChecker;
+		std::vector<uint64_t> visibleMasks;
+		std::vector<VisibleRenderer> visibleRenderers;
+		size_t culledCount;
+		size_t occludedCount;
+	};
+	std::vector<CullChunk> cullChunks = std::vector<CullChunk>(_jobSystem.WorkerCount());
+	std::vector<uint32_t> classifyDependencies = std::vector<uint32_t>();
+	for (uint32_t chunkIndex = 0; chunkIndex < cullChunks.size(); chunkIndex++)
+	{
+		classifyDependencies.emplace_back(frameGraph.AddNode("Cull" + std::to_string(chunkIndex), [&frameSnapshot, &cullChunks, &drawLists, chunkIndex](Command::CommandPool* commandPool) {
+			auto& cameraSnapshot = frameSnapshot->cameras[0];
+			glm::mat4 viewMatrix = cameraSnapshot.viewMatrix;
+			auto& cullChunk = cullChunks[chunkIndex];
+			cullChunk.visibleRenderers.clear();
+			cullChunk.culledCount = 0;
+			cullChunk.occludedCount = 0;
+
+			size_t rendererCount = frameSnapshot->renderers.size();
+			size_t chunkSize = (rendererCount + cullChunks.size() - 1) / cullChunks.size();
+			size_t begin = std::min(rendererCount, chunkSize * chunkIndex);
+			size_t end = std::min(rendererCount, begin + chunkSize);
+			if (begin == end) return;
+
+			//Cached world bounds against world space planes, nothing is transformed per renderer
+			auto& worldClipPlanes = cameraSnapshot.worldClipPlanes;
+			cullChunk.intersectionChecker.SetIntersectPlanes(worldClipPlanes.data(), worldClipPlanes.size());
+			cullChunk.intersectionChecker.Check(frameSnapshot->rendererBounds, begin, end, cullChunk.visibleMasks);
+			auto& depthPyramid = Instance::occlusionManager->DepthPyramid();
+			for (size_t i = begin; i < end; i++)
 			{
-				renderer->SetMatrixData(viewMatrix, projectionMatrix);
-				renderer->material->SetUniformBuffer("cameraData", camera->CameraDataBuffer());
-				renderer->material->SetTextureCube("skyBoxTexture", Instance::lightManager->SkyBoxTexture());
-				renderer->material->SetUniformBuffer("skyBox", Instance::lightManager->SkyBoxBuffer());
-				renderer->material->SetUniformBuffer("mainLight", Instance::lightManager->MainLightBuffer());
-				renderer->material->SetUniformBuffer("importantLight", Instance::lightManager->ImportantLightsBuffer());
-				renderer->material->SetUniformBuffer("unimportantLight", Instance::lightManager->UnimportantLightsBuffer());
-				rendererDistenceMaps[renderer->material->Shader().Settings().renderPass].insert({ obbMvCenter.z, renderer });
+				auto& rendererProxy = frameSnapshot->renderers[i];
+				size_t bit = i - begin;
+				if (rendererProxy.enableFrustumCulling && !((cullChunk.visibleMasks[bit / 64] >> (bit % 64)) & 1))
+				{
+					cullChunk.culledCount++;
+					continue;
+				}
+				//Frustum survivors hidden behind last frame's opaque depth
+				if (rendererProxy.enableFrustumCulling && depthPyramid.IsOccluded(rendererProxy.boundsMin, rendererProxy.boundsMax))
+				{
+					cullChunk.occludedCount++;
+					continue;
+				}
+				auto boundsVCenter = viewMatrix * glm::vec4((rendererProxy.boundsMin + rendererProxy.boundsMax) * 0.5f, 1.0f);
+				auto drawList = drawLists.at(rendererProxy.material->Shader().Settings().renderPass);
+				cullChunk.visibleRenderers.push_back({ &rendererProxy, drawList, drawList->SortKey(&rendererProxy, boundsVCenter.z) });
 			}
-			else
+		}, { depthPyramidNode }));
+	}
+
+	//Merge chunks in renderer order, needs the sky box texture set by the frame upload
+	classifyDependencies.emplace_back(frameUploadNode);
+	uint32_t classifyNode = frameGraph.AddNode("Classify", [&frameSnapshot, &cullChunks, &drawLists](Command::CommandPool* commandPool) {
+		auto& cameraSnapshot = frameSnapshot->cameras[0];
+		auto camera = cameraSnapshot.camera;
+
+		Instance::matrixDataManager->SetMatrixData(cameraSnapshot.viewMatrix, cameraSnapshot.projectionMatrix);
+		Instance::matrixDataManager->Reserve(frameSnapshot->renderers.size());
+		size_t culledCount = 0;
+		size_t occludedCount = 0;
+		for (const auto& cullChunk : cullChunks)
+		{
+			for (const auto& visibleRenderer : cullChunk.visibleRenderers)
 			{
-				Utils::Log::Message("Graphic::Core::Thread::RenderThread cull GameObject called " + renderer->GameObject()->name + ".");
+				auto material = visibleRenderer.rendererProxy->material;
+				material->SetStorageBuffer("matrixData", Instance::matrixDataManager->MatrixDataBuffer(), Instance::matrixDataManager->DynamicOffset());
+				material->SetUniformBuffer("cameraData", camera->CameraDataBuffer());
+				material->SetTextureCube("skyBoxTexture", Instance::lightManager->SkyBoxTexture());
+				material->SetUniformBuffer("skyBox", Instance::lightManager->SkyBoxBuffer());
+				material->SetUniformBuffer("mainLight", Instance::lightManager->MainLightBuffer());
+				material->SetUniformBuffer("importantLight", Instance::lightManager->ImportantLightsBuffer());
+				material->SetUniformBuffer("unimportantLight", Instance::lightManager->UnimportantLightsBuffer());
+				visibleRenderer.drawList->Add(visibleRenderer.rendererProxy, visibleRenderer.sortKey);
 			}
+			culledCount += cullChunk.culledCount;
+			occludedCount += cullChunk.occludedCount;
 		}
+		Utils::Log::Message("Graphic::Core::Thread::RenderThread cull " + std::to_string(culledCount) + " renderer.", culledCount > 0);
+		Utils::Log::Message("Graphic::Core::Thread::RenderThread occlude " + std::to_string(occludedCount) + " renderer.", occludedCount > 0);
 
-		//Add build command buffer task
+		//Batch draws into instance data
 		for (const auto& renderIndexPair : Core::Device::RenderPassManager()._renderIndexMap)
 		{
-			auto& renderPass = Core::Device::RenderPassManager()._renderPasss[renderIndexPair.second];
-			auto rendererDistanceMap = &rendererDistenceMaps[renderIndexPair.second];
-			commandBufferTaskMap[renderIndexPair.second] = AddTask([rendererDistanceMap, renderPass](Command::CommandPool* commandPool) {
-				renderPass->OnPopulateCommandBuffer(commandPool, *rendererDistanceMap);
-				return nullptr;
-			});
+			drawLists[renderIndexPair.second]->Build(*Instance::matrixDataManager);
 		}
+		Instance::matrixDataManager->CopyMatrixData();
+	}, classifyDependencies);
 
-		std::this_thread::yield();
-
-		//Submit command buffers
-		for (const auto& renderIndexPair : Core::Device::RenderPassManager()._renderIndexMap)
-		{
-			auto& renderPass = Core::Device::RenderPassManager()._renderPasss[renderIndexPair.second];
-			commandBufferTaskMap[renderIndexPair.second].get();
-
+	//Passes record in parallel and submit in render index order
+	uint32_t lastSubmitNode = frameUploadNode;
+	for (const auto& renderIndexPair : Core::Device::RenderPassManager()._renderIndexMap)
+	{
+		auto renderPass = Core::Device::RenderPassManager()._renderPasss[renderIndexPair.second];
+		auto drawList = drawLists[renderIndexPair.second];
+		uint32_t recordNode = frameGraph.AddNode("Record" + renderIndexPair.second, [drawList, renderPass](Command::CommandPool* commandPool) {
+			renderPass->OnPopulateCommandBuffer(commandPool, *drawList);
+		}, { classifyNode });
+		lastSubmitNode = frameGraph.AddNode("Submit" + renderIndexPair.second, [renderPass](Command::CommandPool* commandPool) {
 			renderPass->OnRender();
-		}
+		}, { recordNode, lastSubmitNode });
+	}
 
-		uint32_t imageIndex;
-		VkResult result = vkAcquireNextImageKHR(Core::Device::VkDevice_(), Core::Window::VkSwapchainKHR_(), UINT64_MAX, swapchainImageAvailableSemaphore.VkSemphore_(), VK_NULL_HANDLE, &imageIndex);
+	//Present
+	frameGraph.AddNode("Present", [&imageIndex, &presentCommandBuffer, &copyAvailableSemaphore, &swapchainImageAvailableSemaphore](Command::CommandPool* commandPool) {
+		vkAcquireNextImageKHR(Core::Device::VkDevice_(), Core::Window::VkSwapchainKHR_(), UINT64_MAX, swapchainImageAvailableSemaphore.VkSemphore_(), VK_NULL_HANDLE, &imageIndex);
 		presentCommandBuffer->Reset();
 		presentCommandBuffer->BeginRecord(VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT);
 		//Present queue attachment to transfer layout
@@ -311,17 +377,65 @@ void Graphic::Core::Thread::RenderThread::OnRun()
 			presentInfo.waitSemaphoreCount = 1;
 			presentInfo.pWaitSemaphores = &vkSemphmore;
 
-			result = vkQueuePresentKHR(Core::Device::Queue_("PresentQueue").VkQueue_(), &presentInfo);
+			vkQueuePresentKHR(Core::Device::Queue_("PresentQueue").VkQueue_(), &presentInfo);
+		}
+	}, { classifyNode, lastSubmitNode });
+
+	//Moved resources are owned by the render queue family, so the copies stay on that queue
+	Command::CommandPool* defragmentCommandPool = new Command::CommandPool(VkCommandPoolCreateFlagBits::VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, "RenderQueue");
+	Command::CommandBuffer* defragmentCommandBuffer = defragmentCommandPool->CreateCommandBuffer("DefragmentCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+	auto& memoryManager = Core::Device::MemoryManager();
+
+	//Frame time averaged over a window, O toggles occlusion culling to compare
+	const uint32_t frameTimeWindow = 120;
+	uint32_t frameTimeCount = 0;
+	double frameTimeSum = 0;
+	bool occlusionKeyDown = false;
+	//Walking the graph for its critical path is only worth it every so often
+	const uint64_t criticalPathInterval = 120;
+	uint64_t frameCount = 0;
+	//Budget checks lock every chunk, full statistics go out when a heap runs hot and otherwise now and then
+	const uint64_t memoryBudgetInterval = 120;
+	const float memoryBudgetUsageRatio = 0.9f;
+	const uint64_t memoryStatisticsInterval = 3600;
+
+	while (!_stopped && !glfwWindowShouldClose(Core::Window::GLFWwindow_()))
+	{
+		frameSnapshot = Instance::_AcquireRenderFrame();
+		Utils::Log::Message("Graphic::Core::Thread::RenderThread wait render start.");
+		Utils::Log::Message("Graphic::Core::Thread::RenderThread start with " + std::to_string(frameSnapshot->lights.size()) + " light and " + std::to_string(frameSnapshot->cameras.size()) + " camera and " + std::to_string(frameSnapshot->renderers.size()) + " renderer.");
+
+		glfwPollEvents();
+		bool occlusionKeyPressed = glfwGetKey(Core::Window::GLFWwindow_(), GLFW_KEY_O) == GLFW_PRESS;
+		if (occlusionKeyPressed && !occlusionKeyDown)
+		{
+			Instance::occlusionManager->SetEnable(!Instance::occlusionManager->Enabled());
+			frameTimeCount = 0;
+			frameTimeSum = 0;
 		}
+		occlusionKeyDown = occlusionKeyPressed;
 
-		Core::Instance::_lights.clear();
-		Core::Instance::_cameras.clear();
-		Core::Instance::_renderers.clear();
+		auto frameStartTime = std::chrono::steady_clock::now();
+		frameGraph.Run(_jobSystem);
+		frameGraph.Wait();
+		if (++frameCount % criticalPathInterval == 0)
+		{
+			Utils::Log::Message("Graphic::Core::Thread::RenderThread critical path " + frameGraph.CriticalPath() + ".");
+		}
 
-		Utils::Log::Message("Graphic::Core::Thread::RenderThread awake render finish.");
-		Instance::RenderEndCondition().Awake();
+		Utils::Log::Message("Graphic::Core::Thread::RenderThread release frame snapshot.");
+		Instance::_ReleaseRenderFrame();
 
 		presentCommandBuffer->WaitForFinish();
+		frameUploadCommandBuffer->WaitForFinish();
+
+		frameTimeSum += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStartTime).count();
+		if (++frameTimeCount == frameTimeWindow)
+		{
+			Utils::Log::Message("Graphic::Core::Thread::RenderThread average frame " + std::to_string(frameTimeSum / frameTimeCount) + " ms with occlusion culling " + (Instance::occlusionManager->Enabled() ? "on." : "off."));
+			frameTimeCount = 0;
+			frameTimeSum = 0;
+		}
 
 		//Clear
 		for (const auto& renderIndexPair : Core::Device::RenderPassManager()._renderIndexMap)
@@ -329,7 +443,9 @@ void Graphic::Core::Thread::RenderThread::OnRun()
 			auto& renderPass = Core::Device::RenderPassManager()._renderPasss[renderIndexPair.second];
 
 			renderPass->OnClear();
+			drawLists[renderIndexPair.second]->Clear();
 		}
+		Instance::matrixDataManager->Clear();
 		//Reset
 		presentCommandBuffer->Reset();
 		for (const auto& subRenderThread : subRenderThreads)
@@ -337,12 +453,50 @@ void Graphic::Core::Thread::RenderThread::OnRun()
 			subRenderThread->RestCommandPool();
 		}
 
+		//Nothing is recording or in flight on the render side between frames, so resources can move and empty chunks can go
+		//The logic thread may be filling the next snapshot meanwhile, it only keys meshes by pointer and never reads moved handles
+		if (memoryManager.DefragmentBudget() > 0)
+		{
+			defragmentCommandBuffer->Reset();
+			defragmentCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+			bool moved = memoryManager.Defragment(defragmentCommandBuffer);
+			defragmentCommandBuffer->AddPipelineBarrier(
+				VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+				VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT
+			);
+			defragmentCommandBuffer->EndRecord();
+			if (moved)
+			{
+				defragmentCommandBuffer->Submit({}, {}, {});
+				defragmentCommandBuffer->WaitForFinish();
+			}
+			memoryManager.FinishDefragment();
+		}
+		memoryManager.CollectEmptyChunks();
+		if (frameCount % memoryBudgetInterval == 0)
+		{
+			bool overBudget = memoryManager.CheckBudget(memoryBudgetUsageRatio);
+			if (overBudget || frameCount % memoryStatisticsInterval == 0)
+			{
+				Utils::Log::Message("Graphic::Core::Thread::RenderThread memory statistics " + memoryManager.StatisticsJson() + ".");
+			}
+		}
 	}
+
+	for (const auto& drawListPair : drawLists)
+	{
+		delete drawListPair.second;
+	}
+	frameUploadCommandPool->DestoryCommandBuffer("FrameUploadCommandBuffer");
+	delete frameUploadCommandPool;
+	defragmentCommandPool->DestoryCommandBuffer("DefragmentCommandBuffer");
+	delete defragmentCommandPool;
 }
 
 void Graphic::Core::Thread::RenderThread::OnEnd()
 {
 	_stopped = true;
+	_jobSystem.Stop();
 }
 
 Graphic::Core::Thread::Thread()
@@ -371,9 +525,20 @@ void Graphic::Core::Thread::WaitForStartFinish()
 	_renderThread.WaitForStartFinish();
 }
 
-Graphic::Core::Thread::SubRenderThread::SubRenderThread(RenderThread* renderThread)
+size_t Graphic::Core::Thread::SubRenderThreadCount()
+{
+	return _renderThread.subRenderThreads.size();
+}
+
+std::future<Graphic::Command::CommandBuffer*> Graphic::Core::Thread::AddRenderTask(std::function<Graphic::Command::CommandBuffer*(Graphic::Command::CommandPool*)> task)
+{
+	return _renderThread.AddTask(task);
+}
+
+Graphic::Core::Thread::SubRenderThread::SubRenderThread(RenderThread* renderThread, uint32_t workerIndex)
 	: _commandPool(nullptr)
 	, _parentRenderThread(renderThread)
+	, _workerIndex(workerIndex)
 {
 }
 
@@ -402,23 +567,7 @@ void Graphic::Core::Thread::SubRenderThread::OnThreadStart()
 
 void Graphic::Core::Thread::SubRenderThread::OnRun()
 {
-	while (true)
-	{
-		std::function<void(Graphic::Command::CommandPool* const)> task;
-
-		{
-			std::unique_lock<std::mutex> lock(_parentRenderThread->_queueMutex);
-			_parentRenderThread->_queueVariable.wait(lock, [this] { return _parentRenderThread->_stopped || !_parentRenderThread->_tasks.empty(); });
-			if (_parentRenderThread->_stopped && _parentRenderThread->_tasks.empty())
-			{
-				return;
-			}
-			task = std::move(_parentRenderThread->_tasks.front());
-			_parentRenderThread->_tasks.pop();
-		}
-
-		task(_commandPool);
-	}
+	_parentRenderThread->_jobSystem.RunWorker(_workerIndex, _commandPool);
 }
 
 void Graphic::Core::Thread::SubRenderThread::OnEnd()
@@ -5,12 +5,15 @@
 #include <Utils/Log.h>
 using namespace Utils;
 #include "Graphic/Instance/Memory.h"
+#include "Graphic/Command/CommandBuffer.h"
+#include <utility>
 
 Graphic::Instance::Buffer::Buffer(size_t size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties)
 	: _vkBuffer(VK_NULL_HANDLE)
 	, _memoryBlock()
 	, _size(size)
 	, _usage(usage)
+	, _movable(false)
 {
 	VkBufferCreateInfo bufferInfo{};
 	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
@@ -30,31 +33,53 @@ Graphic::Instance::Buffer::Buffer(size_t size, VkBufferUsageFlags usage, VkMemor
 
 void Graphic::Instance::Buffer::WriteBuffer(const void* data, size_t dataSize)
 {
-	std::unique_lock<std::mutex> lock(_memoryBlock.Mutex());
-	{
-		void* transferData;
-		vkMapMemory(Core::Device::VkDevice_(), _memoryBlock.VkMemory(), _memoryBlock.Offset(), _memoryBlock.Size(), 0, &transferData);
-		memcpy(transferData, data, dataSize);
-		vkUnmapMemory(Core::Device::VkDevice_(), _memoryBlock.VkMemory());
-	}
+	Log::Exception("Failed to write buffer without host coherent memory.", !_memoryBlock.MappedData() || !(_memoryBlock.Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+
+	//Blocks never overlap, so writers of one chunk need no lock
+	memcpy(_memoryBlock.MappedData(), data, dataSize);
 }
 void Graphic::Instance::Buffer::WriteBuffer(std::function<void(void*)> writeFunction)
 {
-	std::unique_lock<std::mutex> lock(_memoryBlock.Mutex());
-	{
-		void* transferData;
-		vkMapMemory(Core::Device::VkDevice_(), _memoryBlock.VkMemory(), _memoryBlock.Offset(), _memoryBlock.Size(), 0, &transferData);
+	Log::Exception("Failed to write buffer without host coherent memory.", !_memoryBlock.MappedData() || !(_memoryBlock.Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+
+	writeFunction(_memoryBlock.MappedData());
+}
+
+void Graphic::Instance::Buffer::EnableMove()
+{
+	Log::Exception("Failed to enable move of buffer without transfer usage.", (_usage & (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)) != (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT));
+
+	_movable = true;
+	Core::Device::MemoryManager().RegisterMovable(_memoryBlock, [this](Command::CommandBuffer* commandBuffer) {
+		return _Move(commandBuffer);
+	});
+}
 
-		writeFunction(transferData);
+std::function<void()> Graphic::Instance::Buffer::_Move(Command::CommandBuffer* commandBuffer)
+{
+	//Copy into a fresh buffer, then swap so the temporary one owns and later releases the old memory
+	Buffer* newBuffer = new Buffer(_size, _usage, _memoryBlock.Properties());
+	commandBuffer->CopyBuffer(this, newBuffer);
 
-		vkUnmapMemory(Core::Device::VkDevice_(), _memoryBlock.VkMemory());
-	}
+	std::swap(_vkBuffer, newBuffer->_vkBuffer);
+	std::swap(_memoryBlock, newBuffer->_memoryBlock);
+	return [newBuffer]() {
+		delete newBuffer;
+	};
 }
 
 Graphic::Instance::Buffer::~Buffer()
 {
-	vkDestroyBuffer(Core::Device::VkDevice_(), _vkBuffer, nullptr);
-	Graphic::Core::Device::MemoryManager().ReleaseMemBlock(_memoryBlock);
+	//Captured only once moves are blocked, a move swaps both members
+	auto release = [this]() {
+		return std::function<void()>([vkBuffer = _vkBuffer, memoryBlock = _memoryBlock]() mutable {
+			vkDestroyBuffer(Core::Device::VkDevice_(), vkBuffer, nullptr);
+			Graphic::Core::Device::MemoryManager().ReleaseMemBlock(memoryBlock);
+		});
+	};
+	//A buffer destroyed while its move copy is in flight keeps the destination until the copy finished
+	if (_movable) Graphic::Core::Device::MemoryManager().UnregisterMovable(_memoryBlock, release);
+	else release()();
 
 	_vkBuffer = VK_NULL_HANDLE;
 }
@@ -40,7 +40,7 @@ void Graphic::Instance::DescriptorSet::UpdateBindingData(std::vector<uint32_t> b
 
 	for (size_t i = 0; i < data.size(); i++)
 	{
-		if (data[i].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+		if (data[i].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || data[i].type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER || data[i].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC || data[i].type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)
 		{
 			bufferInfos[i].buffer = data[i].buffer;
 			bufferInfos[i].offset = data[i].offset;
@@ -50,7 +50,7 @@ void Graphic::Instance::DescriptorSet::UpdateBindingData(std::vector<uint32_t> b
 			writeInfos[i].dstSet = _vkDescriptorSet;
 			writeInfos[i].dstBinding = bindingIndex[i];
 			writeInfos[i].dstArrayElement = 0;
-			writeInfos[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			writeInfos[i].descriptorType = data[i].type;
 			writeInfos[i].descriptorCount = 1;
 			writeInfos[i].pBufferInfo = &bufferInfos[i];
 		}
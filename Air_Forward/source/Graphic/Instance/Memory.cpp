@@ -1,25 +1,27 @@
 #include "Graphic/Instance/Memory.h"
 
 Graphic::Instance::Memory::Memory()
-	: Memory(-1, VK_NULL_HANDLE, -1, -1, nullptr, 0)
+	: Memory(-1, VK_NULL_HANDLE, -1, -1, nullptr, nullptr, 0)
 {
 }
-Graphic::Instance::Memory::Memory(uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, VkMemoryPropertyFlags property)
+Graphic::Instance::Memory::Memory(uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, void* mappedData, VkMemoryPropertyFlags property)
 	: _memoryTypeIndex(memoryTypeIndex)
 	, _vkMemory(memory)
 	, _offset(start)
 	, _size(size)
 	, _mutex(mutex)
+	, _mappedData(mappedData)
 	, _isExclusive(false)
 	, _properties(property)
 {
 }
-Graphic::Instance::Memory::Memory(bool isExclusive, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, VkMemoryPropertyFlags property)
+Graphic::Instance::Memory::Memory(bool isExclusive, uint32_t memoryTypeIndex, VkDeviceMemory memory, VkDeviceSize start, VkDeviceSize size, std::mutex* mutex, void* mappedData, VkMemoryPropertyFlags property)
 	: _memoryTypeIndex(memoryTypeIndex)
 	, _vkMemory(memory)
 	, _offset(start)
 	, _size(size)
 	, _mutex(mutex)
+	, _mappedData(mappedData)
 	, _isExclusive(isExclusive)
 	, _properties(property)
 {
@@ -54,3 +56,8 @@ VkMemoryPropertyFlags Graphic::Instance::Memory::Properties()
 {
 	return _properties;
 }
+
+void* Graphic::Instance::Memory::MappedData()
+{
+	return _mappedData;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "Graphic/Instance/RingBuffer.h"
+#include "Graphic/Core/Device.h"
+#include "Graphic/Manager/MemoryManager.h"
+#include "Utils/Log.h"
+#include <algorithm>
+
+Graphic::Instance::RingBuffer::RingBuffer(VkDeviceSize frameSize, uint32_t frameCount, VkBufferUsageFlags usage)
+	: _vkBuffer(VK_NULL_HANDLE)
+	, _memoryBlock()
+	, _mappedData(nullptr)
+	, _usage(usage)
+	, _alignment(1)
+	, _frameSize(frameSize)
+	, _frameCount(frameCount)
+	, _frameIndex(0)
+	, _frameOffset(0)
+	, _version(0)
+	, _retiredBuffers()
+{
+	VkPhysicalDeviceProperties properties{};
+	vkGetPhysicalDeviceProperties(Core::Device::VkPhysicalDevice_(), &properties);
+	if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) _alignment = std::max(_alignment, properties.limits.minUniformBufferOffsetAlignment);
+	if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) _alignment = std::max(_alignment, properties.limits.minStorageBufferOffsetAlignment);
+
+	_Create();
+}
+
+Graphic::Instance::RingBuffer::~RingBuffer()
+{
+	for (auto& retiredBuffer : _retiredBuffers)
+	{
+		_Destroy(retiredBuffer.vkBuffer, retiredBuffer.memoryBlock);
+	}
+	_Destroy(_vkBuffer, _memoryBlock);
+}
+
+void Graphic::Instance::RingBuffer::_Create()
+{
+	_frameSize = (_frameSize + _alignment - 1) & ~(_alignment - 1);
+
+	//A frame sized descriptor range starting at any offset of the last frame needs one more frame of slack
+	VkBufferCreateInfo bufferInfo{};
+	bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferInfo.size = _frameSize * (_frameCount + 1);
+	bufferInfo.usage = _usage;
+	bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	Utils::Log::Exception("Failed to create ring buffer.", vkCreateBuffer(Core::Device::VkDevice_(), &bufferInfo, nullptr, &_vkBuffer));
+
+	VkMemoryRequirements memRequirements;
+	vkGetBufferMemoryRequirements(Core::Device::VkDevice_(), _vkBuffer, &memRequirements);
+
+	_memoryBlock = Core::Device::MemoryManager().AcquireMemory(memRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	vkBindBufferMemory(Core::Device::VkDevice_(), _vkBuffer, _memoryBlock.VkMemory(), _memoryBlock.Offset());
+	_mappedData = reinterpret_cast<char*>(_memoryBlock.MappedData());
+
+	_frameIndex = 0;
+	_frameOffset.store(0);
+	_version++;
+}
+
+void Graphic::Instance::RingBuffer::_Destroy(VkBuffer vkBuffer, Memory& memoryBlock)
+{
+	vkDestroyBuffer(Core::Device::VkDevice_(), vkBuffer, nullptr);
+	Core::Device::MemoryManager().ReleaseMemBlock(memoryBlock);
+}
+
+void Graphic::Instance::RingBuffer::Resize(VkDeviceSize frameSize)
+{
+	_retiredBuffers.push_back({ _vkBuffer, _memoryBlock, _frameCount });
+	_vkBuffer = VK_NULL_HANDLE;
+	_mappedData = nullptr;
+	_frameSize = frameSize;
+	_Create();
+}
+
+void Graphic::Instance::RingBuffer::NextFrame()
+{
+	_frameIndex = (_frameIndex + 1) % _frameCount;
+	_frameOffset.store(0);
+
+	//A retired buffer outlives every frame that was recorded against it
+	for (size_t i = 0; i < _retiredBuffers.size(); )
+	{
+		if (--_retiredBuffers[i].remainingFrameCount == 0)
+		{
+			_Destroy(_retiredBuffers[i].vkBuffer, _retiredBuffers[i].memoryBlock);
+			_retiredBuffers[i] = _retiredBuffers.back();
+			_retiredBuffers.pop_back();
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+uint32_t Graphic::Instance::RingBuffer::Allocate(VkDeviceSize size, void** data)
+{
+	VkDeviceSize alignedSize = (size + _alignment - 1) & ~(_alignment - 1);
+	VkDeviceSize offset = _frameOffset.fetch_add(alignedSize);
+	Utils::Log::Exception("Ring buffer frame is out of space.", offset + size > _frameSize);
+
+	VkDeviceSize dynamicOffset = _frameSize * _frameIndex + offset;
+	*data = _mappedData + dynamicOffset;
+	return static_cast<uint32_t>(dynamicOffset);
+}
+
+VkBuffer Graphic::Instance::RingBuffer::VkBuffer_()
+{
+	return _vkBuffer;
+}
+
+VkDeviceSize Graphic::Instance::RingBuffer::Range()
+{
+	return _frameSize;
+}
+
+uint32_t Graphic::Instance::RingBuffer::Version()
+{
+	return _version;
+}
\ No newline at end of file
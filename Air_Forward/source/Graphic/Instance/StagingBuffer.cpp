@@ -0,0 +1,55 @@
+#include "Graphic/Instance/StagingBuffer.h"
+#include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/Memory.h"
+#include <algorithm>
+
+Graphic::Instance::StagingBuffer::StagingBuffer(VkDeviceSize size)
+	: _buffer(new Buffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+	, _mappedData(nullptr)
+	, _size(size)
+	, _head(0)
+	, _retiredBuffers()
+{
+	_mappedData = reinterpret_cast<char*>(_buffer->Memory().MappedData());
+}
+
+Graphic::Instance::StagingBuffer::~StagingBuffer()
+{
+	Reset();
+	delete _buffer;
+}
+
+Graphic::Instance::StagingBuffer::Allocation Graphic::Instance::StagingBuffer::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+{
+	VkDeviceSize offset = (_head + alignment - 1) & ~(alignment - 1);
+	if (offset + size > _size)
+	{
+		//Copies recorded from the current buffer are still pending, so it is only retired
+		_retiredBuffers.emplace_back(_buffer);
+		_size = std::max(_size * 2, size);
+		_buffer = new Buffer(_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+		_mappedData = reinterpret_cast<char*>(_buffer->Memory().MappedData());
+		offset = 0;
+	}
+	_head = offset + size;
+	return Allocation{ _buffer, offset, _mappedData + offset };
+}
+
+void Graphic::Instance::StagingBuffer::Reset()
+{
+	for (auto& retiredBuffer : _retiredBuffers)
+	{
+		delete retiredBuffer;
+	}
+	_retiredBuffers.clear();
+	_head = 0;
+}
+
+VkDeviceSize Graphic::Instance::StagingBuffer::Size()
+{
+	return _size;
+}
+VkDeviceSize Graphic::Instance::StagingBuffer::Used()
+{
+	return _head;
+}
@@ -6,21 +6,19 @@
 #include <map>
 #include "Utils/Log.h"
 
-void Graphic::Manager::LightManager::SetLightData(std::vector<Logic::Component::Component*> lights)
+void Graphic::Manager::LightManager::SetLightData(std::vector<Core::FrameSnapshot::LightSnapshot>& lights)
 {
-	std::multimap<Logic::Component::Light::Light::LightType, Logic::Component::Light::Light*> lightMap = std::multimap<Logic::Component::Light::Light::LightType, Logic::Component::Light::Light*>();
-	for (const auto& lightComponent : lights)
+	std::multimap<Logic::Component::Light::Light::LightType, Core::FrameSnapshot::LightSnapshot*> lightMap = std::multimap<Logic::Component::Light::Light::LightType, Core::FrameSnapshot::LightSnapshot*>();
+	for (auto& light : lights)
 	{
-		Logic::Component::Light::Light* light = static_cast<Logic::Component::Light::Light*>(lightComponent);
-		lightMap.emplace(std::make_pair( light->lightType, light ));
+		lightMap.emplace(std::make_pair(light.lightType, &light));
 	}
 	//skybox
 	auto skyBoxIterator = lightMap.find(Logic::Component::Light::Light::LightType::SKY_BOX);
 	if (skyBoxIterator != std::end(lightMap))
 	{
-		auto data = skyBoxIterator->second->GetLightData();
-		_skyBoxData = *reinterpret_cast<LightData*>(&data);
-		_skyBoxTexture = static_cast<Logic::Component::Light::SkyBox*>(skyBoxIterator->second)->TextureCube();
+		_skyBoxData = *reinterpret_cast<LightData*>(&skyBoxIterator->second->lightData);
+		_skyBoxTexture = skyBoxIterator->second->textureCube;
 	}
 	else
 	{
@@ -32,8 +30,7 @@ void Graphic::Manager::LightManager::SetLightData(std::vector<Logic::Component::
 	auto directionalIterator = lightMap.find(Logic::Component::Light::Light::LightType::DIRECTIONAL);
 	if (directionalIterator != std::end(lightMap))
 	{
-		auto data = directionalIterator->second->GetLightData();
-		_mainLightData = *reinterpret_cast<LightData*>(&data);
+		_mainLightData = *reinterpret_cast<LightData*>(&directionalIterator->second->lightData);
 	}
 	else
 	{
@@ -46,8 +43,7 @@ void Graphic::Manager::LightManager::SetLightData(std::vector<Logic::Component::
 	{
 		if (pointIterator != std::end(lightMap))
 		{
-			auto data = pointIterator->second->GetLightData();
-			_importantLightData[i] = *reinterpret_cast<LightData*>(&data);
+			_importantLightData[i] = *reinterpret_cast<LightData*>(&pointIterator->second->lightData);
 			pointIterator++;
 		}
 		else
@@ -61,8 +57,7 @@ void Graphic::Manager::LightManager::SetLightData(std::vector<Logic::Component::
 	{
 		if (pointIterator != std::end(lightMap))
 		{
-			auto data = pointIterator->second->GetLightData();
-			_unimportantLightData[i] = *reinterpret_cast<LightData*>(&data);
+			_unimportantLightData[i] = *reinterpret_cast<LightData*>(&pointIterator->second->lightData);
 			pointIterator++;
 		}
 		else
@@ -83,15 +78,10 @@ void Graphic::Manager::LightManager::CopyLightData(Command::CommandBuffer* comma
 	});
 
 	VkDeviceSize dataSize = sizeof(LightData);
-	commandBuffer->Reset();
-	commandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 	commandBuffer->CopyBuffer(_stageBuffer, 0, _skyBoxBuffer, 0, dataSize);
 	commandBuffer->CopyBuffer(_stageBuffer, dataSize, _mainLightBuffer, 0, dataSize);
 	commandBuffer->CopyBuffer(_stageBuffer, dataSize * 2, _importantLightsBuffer, 0, dataSize * 4);
 	commandBuffer->CopyBuffer(_stageBuffer, dataSize * 6, _unimportantLightsBuffer, 0, dataSize * 4);
-	commandBuffer->EndRecord();
-	commandBuffer->Submit({}, {}, {});
-	commandBuffer->WaitForFinish();
 }
 
 Graphic::Manager::LightManager::LightManager()
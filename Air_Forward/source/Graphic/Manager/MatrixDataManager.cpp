@@ -0,0 +1,79 @@
+#include "Graphic/Manager/MatrixDataManager.h"
+#include "Graphic/Instance/RingBuffer.h"
+#include "Graphic/Core/Instance.h"
+#include "Utils/Log.h"
+#include <algorithm>
+
+void Graphic::Manager::MatrixDataManager::SetMatrixData(const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix)
+{
+	_matrixData.view = viewMatrix;
+	_matrixData.projection = projectionMatrix;
+}
+
+void Graphic::Manager::MatrixDataManager::Reserve(size_t instanceCount)
+{
+	if (instanceCount > _instanceCapacity)
+	{
+		//The ring keeps the old buffer alive until every frame that may still read it has cycled out
+		_instanceCapacity = std::max(instanceCount, _instanceCapacity * 2);
+		_matrixDataBuffer->Resize(sizeof(MatrixData) + sizeof(InstanceData) * _instanceCapacity);
+	}
+
+	//Write straight into this frame's segment of the ring
+	void* data = nullptr;
+	_matrixDataBuffer->NextFrame();
+	_dynamicOffset = _matrixDataBuffer->Allocate(sizeof(MatrixData) + sizeof(InstanceData) * instanceCount, &data);
+	_frameMatrixData = reinterpret_cast<MatrixData*>(data);
+	_frameInstanceDatas = reinterpret_cast<InstanceData*>(reinterpret_cast<char*>(data) + sizeof(MatrixData));
+	_frameInstanceCapacity = instanceCount;
+	_frameInstanceCount = 0;
+}
+
+uint32_t Graphic::Manager::MatrixDataManager::AddInstanceData(const glm::mat4& modelMatrix)
+{
+	Utils::Log::Exception("Graphic::Manager::MatrixDataManager instance data out of capacity.", _frameInstanceCount >= _frameInstanceCapacity);
+
+	_frameInstanceDatas[_frameInstanceCount] = { modelMatrix, glm::transpose(glm::inverse(modelMatrix)) };
+	return static_cast<uint32_t>(_frameInstanceCount++);
+}
+
+void Graphic::Manager::MatrixDataManager::CopyMatrixData()
+{
+	*_frameMatrixData = _matrixData;
+}
+
+void Graphic::Manager::MatrixDataManager::Clear()
+{
+	_frameMatrixData = nullptr;
+	_frameInstanceDatas = nullptr;
+	_frameInstanceCapacity = 0;
+	_frameInstanceCount = 0;
+}
+
+Graphic::Instance::RingBuffer* Graphic::Manager::MatrixDataManager::MatrixDataBuffer()
+{
+	return _matrixDataBuffer;
+}
+
+uint32_t Graphic::Manager::MatrixDataManager::DynamicOffset()
+{
+	return _dynamicOffset;
+}
+
+Graphic::Manager::MatrixDataManager::MatrixDataManager()
+	: _matrixDataBuffer(nullptr)
+	, _instanceCapacity(64)
+	, _matrixData()
+	, _frameMatrixData(nullptr)
+	, _frameInstanceDatas(nullptr)
+	, _frameInstanceCapacity(0)
+	, _frameInstanceCount(0)
+	, _dynamicOffset(0)
+{
+	_matrixDataBuffer = new Instance::RingBuffer(sizeof(MatrixData) + sizeof(InstanceData) * _instanceCapacity, Core::Instance::FramesInFlight(), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+}
+
+Graphic::Manager::MatrixDataManager::~MatrixDataManager()
+{
+	delete _matrixDataBuffer;
+}
\ No newline at end of file
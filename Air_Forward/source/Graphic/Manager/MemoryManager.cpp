@@ -2,25 +2,17 @@
 #include <Graphic/Core/Device.h>
 #include "Utils/Log.h"
 #include "Graphic/Instance/Memory.h"
+#include <json.hpp>
+#include <algorithm>
 using namespace Utils;
-Graphic::Manager::MemoryManager::MemoryChunkUsage::MemoryChunkUsage(VkDeviceSize start, VkDeviceSize size)
-	: offset(start)
-	, size(size)
-{
-
-}
 
-Graphic::Manager::MemoryManager::MemoryChunkUsage::MemoryChunkUsage()
-	: MemoryChunkUsage(-1, -1)
-{
-}
-
-
-Graphic::Manager::MemoryManager::MemoryChunk::MemoryChunk(uint32_t typeIndex, VkDeviceSize size)
+Graphic::Manager::MemoryManager::MemoryChunk::MemoryChunk(uint32_t typeIndex, VkDeviceSize size, bool hostVisible)
 	: size(size)
 	, mutex(new std::mutex())
-	, allocated({})
-	, unallocated({ {0, Graphic::Manager::MemoryManager::MemoryChunkUsage(0, size)} })
+	, mappedData(nullptr)
+	, allocator(size)
+	, draining(false)
+	, emptyCollectCount(0)
 {
 	VkMemoryAllocateInfo allocInfo{};
 	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
@@ -28,10 +20,19 @@ Graphic::Manager::MemoryManager::MemoryChunk::MemoryChunk(uint32_t typeIndex, Vk
 	allocInfo.memoryTypeIndex = typeIndex;
 
 	Log::Exception("Failed to allocate memory chunk.", vkAllocateMemory(Core::Device::VkDevice_(), &allocInfo, nullptr, &memory));
+
+	//Map the whole chunk once, blocks write through disjoint ranges of it
+	if (hostVisible)
+	{
+		void* data = nullptr;
+		Log::Exception("Failed to map memory chunk.", vkMapMemory(Core::Device::VkDevice_(), memory, 0, size, 0, &data));
+		mappedData = reinterpret_cast<char*>(data);
+	}
 }
 
 Graphic::Manager::MemoryManager::MemoryChunk::~MemoryChunk()
 {
+	if (mappedData) vkUnmapMemory(Core::Device::VkDevice_(), memory);
 	vkFreeMemory(Core::Device::VkDevice_(), memory, nullptr);
 	delete mutex;
 }
@@ -39,6 +40,14 @@ Graphic::Manager::MemoryManager::MemoryChunk::~MemoryChunk()
 
 Graphic::Manager::MemoryManager::MemoryManager(VkDeviceSize defaultSize)
 	: _defaultSize(defaultSize)
+	, _movables()
+	, _pendingReleases()
+	, _movingMemories()
+	, _movableMutex()
+	, _defragmentTypeIndex(0)
+	, _defragmentMemory(VK_NULL_HANDLE)
+	, _defragmentBudget(0)
+	, _defragmentUsageRatio(0)
 {
 	VkPhysicalDeviceMemoryProperties memProperties;
 	vkGetPhysicalDeviceMemoryProperties(Core::Device::VkPhysicalDevice_(), &memProperties);
@@ -57,6 +66,14 @@ Graphic::Manager::MemoryManager::MemoryManager(VkDeviceSize defaultSize)
 		_chunkSetMutexs[i] = new std::mutex();
 	}
 
+	_exclusiveCounts.resize(memProperties.memoryTypeCount, 0);
+	_exclusiveSizes.resize(memProperties.memoryTypeCount, 0);
+	_heapIndexs.resize(memProperties.memoryTypeCount);
+	for (size_t i = 0; i < _heapIndexs.size(); i++)
+	{
+		_heapIndexs[i] = memProperties.memoryTypes[i].heapIndex;
+	}
+
 }
 
 Graphic::Manager::MemoryManager::~MemoryManager()
@@ -68,6 +85,35 @@ Graphic::Manager::MemoryManager::~MemoryManager()
 	}
 }
 
+void* Graphic::Manager::MemoryManager::_Map(VkDeviceMemory memory, VkDeviceSize size, VkMemoryPropertyFlags properties)
+{
+	if (!(properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) return nullptr;
+
+	void* data = nullptr;
+	Log::Exception("Failed to map exculsive memory.", vkMapMemory(Core::Device::VkDevice_(), memory, 0, size, 0, &data));
+	return data;
+}
+
+Graphic::Instance::Memory Graphic::Manager::MemoryManager::_AllocateExclusive(uint32_t typeIndex, VkDeviceSize size, VkMemoryPropertyFlags properties)
+{
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = size;
+	allocInfo.memoryTypeIndex = typeIndex;
+
+	VkDeviceMemory newMemory = VK_NULL_HANDLE;
+	Log::Exception("Failed to allocate exculsive memory.", vkAllocateMemory(Core::Device::VkDevice_(), &allocInfo, nullptr, &newMemory));
+	std::mutex* newMutex = new std::mutex();
+
+	{
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[typeIndex]);
+		_exclusiveCounts[typeIndex]++;
+		_exclusiveSizes[typeIndex] += size;
+	}
+
+	return Instance::Memory(true, typeIndex, newMemory, 0, size, newMutex, _Map(newMemory, size, _propertys[typeIndex]), properties);
+}
+
 Graphic::Instance::Memory Graphic::Manager::MemoryManager::AcquireMemory(VkMemoryRequirements& requirement, VkMemoryPropertyFlags properties)
 {
 	VkDeviceSize newSize = (requirement.size + requirement.alignment - 1) & ~(requirement.alignment - 1);
@@ -80,43 +126,28 @@ Graphic::Instance::Memory Graphic::Manager::MemoryManager::AcquireMemory(VkMemor
 			
 			for (auto& chunkPair : _chunkSets[i])
 			{
+				if (chunkPair.second->draining) continue;
 				std::unique_lock<std::mutex> chunkLock(*chunkPair.second->mutex);
 
-				for (auto& usagePair : chunkPair.second->unallocated)
+				VkDeviceSize offset = 0;
+				if (chunkPair.second->allocator.Allocate(newSize, requirement.alignment, offset))
 				{
-					if (usagePair.second.size < requirement.size) continue;
-
-					VkDeviceSize newStart = (usagePair.second.offset + requirement.alignment - 1) & ~(requirement.alignment - 1);
-					VkDeviceSize newEnd = newStart + newSize;
-
-					VkDeviceSize oldStart = usagePair.second.offset;
-					VkDeviceSize oldSize = usagePair.second.size;
-					VkDeviceSize oldEnd = oldStart + oldSize;
-
-					if (newEnd <= oldEnd)
-					{
-						if (newStart == oldStart)
-						{
-							chunkPair.second->unallocated.erase(oldStart);
-						}
-						else
-						{
-							usagePair.second.size = newStart - oldStart;
-						}
-						if (oldEnd > newEnd) chunkPair.second->unallocated.emplace(newEnd, MemoryChunkUsage(newEnd, oldEnd - newEnd));
-						chunkPair.second->allocated.emplace(newStart, MemoryChunkUsage(newStart, newSize));
-						return Instance::Memory(i, chunkPair.second->memory, newStart, newSize, chunkPair.second->mutex, properties);
-					}
+					return Instance::Memory(i, chunkPair.second->memory, offset, newSize, chunkPair.second->mutex, chunkPair.second->mappedData ? chunkPair.second->mappedData + offset : nullptr, properties);
 				}
 			}
 
-			MemoryChunk* newChunk = new MemoryChunk(i, _defaultSize);
-			newChunk->unallocated.clear();
-			if(_defaultSize > newSize) newChunk->unallocated.emplace(newSize, MemoryChunkUsage(newSize, _defaultSize - newSize));
-			newChunk->allocated.emplace(0, MemoryChunkUsage(0, newSize));
+			MemoryChunk* newChunk = new MemoryChunk(i, _defaultSize, _propertys[i] & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+			VkDeviceSize offset = 0;
+			if (!newChunk->allocator.Allocate(newSize, requirement.alignment, offset))
+			{
+				//Alignment padding can push a block that fits by size out of a fresh chunk
+				delete newChunk;
+				chunkSetLock.unlock();
+				return AcquireExclusiveMemory(requirement, properties);
+			}
 
 			_chunkSets[i].emplace(newChunk->memory, std::shared_ptr<MemoryChunk>(newChunk));
-			return Instance::Memory(i, newChunk->memory, 0, newSize, newChunk->mutex, properties);
+			return Instance::Memory(i, newChunk->memory, offset, newSize, newChunk->mutex, newChunk->mappedData ? newChunk->mappedData + offset : nullptr, properties);
 		}
 	}
 
@@ -125,16 +156,7 @@ EXCLUSIVE:
 	{
 		if ((requirement.memoryTypeBits & (1 << i)) && (_propertys[i] & properties) == properties)
 		{
-			VkMemoryAllocateInfo allocInfo{};
-			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			allocInfo.allocationSize = newSize;
-			allocInfo.memoryTypeIndex = i;
-
-			VkDeviceMemory newMemory = VK_NULL_HANDLE;
-			Log::Exception("Failed to allocate exculsive memory.", vkAllocateMemory(Core::Device::VkDevice_(), &allocInfo, nullptr, &newMemory));
-			std::mutex* newMutex = new std::mutex();
-
-			return Instance::Memory(true, i, newMemory, 0, newSize, newMutex, properties);
+			return _AllocateExclusive(i, newSize, properties);
 		}
 	}
 
@@ -148,16 +170,7 @@ Graphic::Instance::Memory Graphic::Manager::MemoryManager::AcquireExclusiveMemor
 	{
 		if ((requirement.memoryTypeBits & (1 << i)) && (_propertys[i] & properties) == properties)
 		{
-			VkMemoryAllocateInfo allocInfo{};
-			allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			allocInfo.allocationSize = newSize;
-			allocInfo.memoryTypeIndex = i;
-
-			VkDeviceMemory newMemory = VK_NULL_HANDLE;
-			Log::Exception("Failed to allocate exculsive memory.", vkAllocateMemory(Core::Device::VkDevice_(), &allocInfo, nullptr, &newMemory));
-			std::mutex* newMutex = new std::mutex();
-
-			return Instance::Memory(true, i, newMemory, 0, newSize, newMutex, properties);
+			return _AllocateExclusive(i, newSize, properties);
 		}
 	}
 
@@ -168,8 +181,13 @@ void Graphic::Manager::MemoryManager::ReleaseMemBlock(Instance::Memory& memoryBl
 {
 	if (memoryBlock._isExclusive)
 	{
+		if (memoryBlock._mappedData) vkUnmapMemory(Core::Device::VkDevice_(), memoryBlock._vkMemory);
 		vkFreeMemory(Core::Device::VkDevice_(), memoryBlock._vkMemory, nullptr);
 		delete memoryBlock._mutex;
+
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[memoryBlock._memoryTypeIndex]);
+		_exclusiveCounts[memoryBlock._memoryTypeIndex]--;
+		_exclusiveSizes[memoryBlock._memoryTypeIndex] -= memoryBlock._size;
 		return;
 	}
 	else
@@ -177,47 +195,287 @@ void Graphic::Manager::MemoryManager::ReleaseMemBlock(Instance::Memory& memoryBl
 		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[memoryBlock._memoryTypeIndex]);
 		MemoryChunk* chunk = _chunkSets[memoryBlock._memoryTypeIndex][memoryBlock._vkMemory].get();
 
+		std::unique_lock<std::mutex> chunkLock(*chunk->mutex);
+		chunk->allocator.Free(memoryBlock._offset);
+	}
+}
+
+Graphic::Manager::MemoryManager::MemoryStatistics Graphic::Manager::MemoryManager::Statistics()
+{
+	MemoryStatistics statistics{};
+
+	statistics.types.resize(_propertys.size());
+	for (uint32_t i = 0; i < _propertys.size(); i++)
+	{
+		MemoryTypeStatistics& typeStatistics = statistics.types[i];
+		typeStatistics.heapIndex = _heapIndexs[i];
+		typeStatistics.propertyFlags = _propertys[i];
+
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[i]);
+		typeStatistics.exclusiveAllocationCount = _exclusiveCounts[i];
+		typeStatistics.exclusiveBytes = _exclusiveSizes[i];
+		for (auto& chunkPair : _chunkSets[i])
+		{
+			std::unique_lock<std::mutex> chunkLock(*chunkPair.second->mutex);
+			Utils::TlsfAllocator& allocator = chunkPair.second->allocator;
+			typeStatistics.chunkCount++;
+			typeStatistics.chunkBytes += chunkPair.second->size;
+			typeStatistics.allocatedBytes += allocator.AllocatedSize();
+			typeStatistics.freeBytes += allocator.Size() - allocator.AllocatedSize();
+			typeStatistics.largestFreeBlock = std::max<VkDeviceSize>(typeStatistics.largestFreeBlock, allocator.LargestFreeSize());
+			typeStatistics.allocationCount += allocator.AllocationCount();
+		}
+	}
+
+	VkPhysicalDeviceMemoryProperties2 memProperties{};
+	memProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+	VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{};
+	budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+	bool hasBudget = Core::Device::ExtensionEnabled(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+	if (hasBudget) memProperties.pNext = &budgetProperties;
+	vkGetPhysicalDeviceMemoryProperties2(Core::Device::VkPhysicalDevice_(), &memProperties);
+
+	statistics.heaps.resize(memProperties.memoryProperties.memoryHeapCount);
+	for (uint32_t i = 0; i < statistics.heaps.size(); i++)
+	{
+		MemoryHeapStatistics& heapStatistics = statistics.heaps[i];
+		heapStatistics.flags = memProperties.memoryProperties.memoryHeaps[i].flags;
+		heapStatistics.size = memProperties.memoryProperties.memoryHeaps[i].size;
+		heapStatistics.hasBudget = hasBudget;
+		if (hasBudget)
+		{
+			heapStatistics.usage = budgetProperties.heapUsage[i];
+			heapStatistics.budget = budgetProperties.heapBudget[i];
+		}
+		else
+		{
+			heapStatistics.budget = heapStatistics.size;
+		}
+	}
+	if (!hasBudget)
+	{
+		for (const auto& typeStatistics : statistics.types)
+		{
+			statistics.heaps[typeStatistics.heapIndex].usage += typeStatistics.chunkBytes + typeStatistics.exclusiveBytes;
+		}
+	}
+
+	return statistics;
+}
+
+std::string Graphic::Manager::MemoryManager::StatisticsJson()
+{
+	MemoryStatistics statistics = Statistics();
+
+	nlohmann::json j;
+	j["types"] = nlohmann::json::array();
+	for (uint32_t i = 0; i < statistics.types.size(); i++)
+	{
+		const MemoryTypeStatistics& typeStatistics = statistics.types[i];
+		j["types"].push_back({
+			{ "index", i },
+			{ "heapIndex", typeStatistics.heapIndex },
+			{ "propertyFlags", typeStatistics.propertyFlags },
+			{ "chunkCount", typeStatistics.chunkCount },
+			{ "chunkBytes", typeStatistics.chunkBytes },
+			{ "allocatedBytes", typeStatistics.allocatedBytes },
+			{ "freeBytes", typeStatistics.freeBytes },
+			{ "largestFreeBlock", typeStatistics.largestFreeBlock },
+			{ "allocationCount", typeStatistics.allocationCount },
+			{ "exclusiveAllocationCount", typeStatistics.exclusiveAllocationCount },
+			{ "exclusiveBytes", typeStatistics.exclusiveBytes }
+		});
+	}
+	j["heaps"] = nlohmann::json::array();
+	for (uint32_t i = 0; i < statistics.heaps.size(); i++)
+	{
+		const MemoryHeapStatistics& heapStatistics = statistics.heaps[i];
+		j["heaps"].push_back({
+			{ "index", i },
+			{ "flags", heapStatistics.flags },
+			{ "size", heapStatistics.size },
+			{ "usage", heapStatistics.usage },
+			{ "budget", heapStatistics.budget },
+			{ "hasBudget", heapStatistics.hasBudget }
+		});
+	}
+	return j.dump(4);
+}
+
+bool Graphic::Manager::MemoryManager::CheckBudget(float usageRatio)
+{
+	MemoryStatistics statistics = Statistics();
+
+	bool overBudget = false;
+	for (uint32_t i = 0; i < statistics.heaps.size(); i++)
+	{
+		const MemoryHeapStatistics& heapStatistics = statistics.heaps[i];
+		if (heapStatistics.usage > heapStatistics.budget * usageRatio)
 		{
-			std::unique_lock<std::mutex> chunkLock(*chunk->mutex);
-			chunk->allocated.erase(memoryBlock._offset);
+			overBudget = true;
+			Log::Message("Memory heap " + std::to_string(i) + " uses " + std::to_string(heapStatistics.usage) + " of its " + std::to_string(heapStatistics.budget) + " bytes budget.");
+		}
+	}
+	return overBudget;
+}
 
-			VkDeviceSize recycleStart = memoryBlock._offset;
-			VkDeviceSize recycleSize = memoryBlock._size;
-			VkDeviceSize recycleEnd = recycleStart + recycleSize;
+void Graphic::Manager::MemoryManager::CollectEmptyChunks()
+{
+	std::unique_lock<std::mutex> movableLock(_movableMutex);
+	for (uint32_t i = 0; i < _chunkSets.size(); i++)
+	{
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[i]);
+
+		bool keptEmptyChunk = false;
+		for (auto iterator = _chunkSets[i].begin(); iterator != _chunkSets[i].end(); )
+		{
+			MemoryChunk* chunk = iterator->second.get();
+			{
+				std::unique_lock<std::mutex> chunkLock(*chunk->mutex);
+				chunk->emptyCollectCount = chunk->allocator.AllocationCount() == 0 ? chunk->emptyCollectCount + 1 : 0;
+			}
 
-			bool merged = false;
-			for (auto& usagePair : chunk->unallocated)
+			//Keep one idle chunk so a load right after an unload does not reallocate device memory
+			if (chunk->emptyCollectCount == 0 || (!keptEmptyChunk && !chunk->draining))
+			{
+				keptEmptyChunk |= chunk->emptyCollectCount > 0;
+				++iterator;
+			}
+			else if (chunk->emptyCollectCount >= EMPTY_CHUNK_COLLECT_COUNT || chunk->draining)
 			{
-				MemoryChunkUsage usage = usagePair.second;
-				if (usage.offset < recycleStart)
+				if (chunk->memory == _defragmentMemory) _defragmentMemory = VK_NULL_HANDLE;
+				iterator = _chunkSets[i].erase(iterator);
+			}
+			else
+			{
+				++iterator;
+			}
+		}
+	}
+}
+
+void Graphic::Manager::MemoryManager::RegisterMovable(Instance::Memory& memory, std::function<std::function<void()>(Command::CommandBuffer*)> move)
+{
+	if (memory._isExclusive) return;
+
+	std::unique_lock<std::mutex> movableLock(_movableMutex);
+	_movables[&memory] = move;
+}
+
+void Graphic::Manager::MemoryManager::UnregisterMovable(Instance::Memory& memory, std::function<std::function<void()>()> release)
+{
+	std::function<void()> currentRelease;
+	{
+		std::unique_lock<std::mutex> movableLock(_movableMutex);
+		_movables.erase(&memory);
+		currentRelease = release();
+		if (_movingMemories.count(&memory))
+		{
+			_movingMemories.erase(&memory);
+			_pendingReleases.emplace_back(currentRelease);
+			return;
+		}
+	}
+	currentRelease();
+}
+
+void Graphic::Manager::MemoryManager::SetDefragmentBudget(VkDeviceSize bytesPerPass, float usageRatio)
+{
+	std::unique_lock<std::mutex> movableLock(_movableMutex);
+	_defragmentBudget = bytesPerPass;
+	_defragmentUsageRatio = usageRatio;
+}
+
+VkDeviceSize Graphic::Manager::MemoryManager::DefragmentBudget()
+{
+	return _defragmentBudget;
+}
+
+bool Graphic::Manager::MemoryManager::Defragment(Command::CommandBuffer* commandBuffer)
+{
+	std::unique_lock<std::mutex> movableLock(_movableMutex);
+	if (_defragmentBudget == 0) return false;
+
+	//Pick the sparsest chunk holding movable blocks whose content fits into the rest of its memory type
+	if (_defragmentMemory == VK_NULL_HANDLE)
+	{
+		std::map<VkDeviceMemory, uint32_t> candidates;
+		for (const auto& movablePair : _movables)
+		{
+			candidates[movablePair.first->_vkMemory] = movablePair.first->_memoryTypeIndex;
+		}
+
+		float lowestUsage = _defragmentUsageRatio;
+		for (const auto& candidate : candidates)
+		{
+			std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[candidate.second]);
+			VkDeviceSize usedSize = 0;
+			VkDeviceSize otherFreeSize = 0;
+			float usage = 1;
+			for (auto& chunkPair : _chunkSets[candidate.second])
+			{
+				std::unique_lock<std::mutex> chunkLock(*chunkPair.second->mutex);
+				Utils::TlsfAllocator& allocator = chunkPair.second->allocator;
+				if (chunkPair.first == candidate.first)
 				{
-					if (usage.offset + usage.size == recycleStart)
-					{
-						merged = true;
-						if (chunk->unallocated.count(recycleEnd))
-						{
-							usagePair.second.size = usage.size + recycleSize + chunk->unallocated[recycleEnd].size;
-							chunk->unallocated.erase(recycleEnd);
-						}
-						else
-						{
-							usagePair.second.size = usage.size + recycleSize;
-						}
-						return;
-					}
+					usedSize = allocator.AllocatedSize();
+					usage = static_cast<float>(usedSize) / allocator.Size();
 				}
 				else
 				{
-					break;
+					otherFreeSize += allocator.Size() - allocator.AllocatedSize();
 				}
-
 			}
-			if (!merged)
+			if (usage < lowestUsage && usedSize <= otherFreeSize)
 			{
-				chunk->unallocated.emplace(recycleStart, MemoryChunkUsage{ recycleStart , recycleSize });
-				return;
+				lowestUsage = usage;
+				_defragmentTypeIndex = candidate.second;
+				_defragmentMemory = candidate.first;
 			}
 		}
-		Log::Exception("Failed to release memory.");
+		if (_defragmentMemory == VK_NULL_HANDLE) return false;
+
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[_defragmentTypeIndex]);
+		_chunkSets[_defragmentTypeIndex][_defragmentMemory]->draining = true;
+	}
+
+	//Draining chunks take no new blocks, so moved blocks land in other chunks
+	VkDeviceSize movedSize = 0;
+	bool finished = true;
+	for (const auto& movablePair : _movables)
+	{
+		if (movablePair.first->_vkMemory != _defragmentMemory) continue;
+		if (movedSize >= _defragmentBudget)
+		{
+			finished = false;
+			break;
+		}
+		movedSize += movablePair.first->_size;
+		_pendingReleases.emplace_back(movablePair.second(commandBuffer));
+		_movingMemories.insert(movablePair.first);
+	}
+
+	//Whatever is left in the chunk cannot move, let it take blocks again
+	if (finished)
+	{
+		std::unique_lock<std::mutex> chunkSetLock(*_chunkSetMutexs[_defragmentTypeIndex]);
+		auto iterator = _chunkSets[_defragmentTypeIndex].find(_defragmentMemory);
+		if (iterator != _chunkSets[_defragmentTypeIndex].end()) iterator->second->draining = false;
+		_defragmentMemory = VK_NULL_HANDLE;
+	}
+	return movedSize > 0;
+}
+
+void Graphic::Manager::MemoryManager::FinishDefragment()
+{
+	std::vector<std::function<void()>> pendingReleases;
+	{
+		std::unique_lock<std::mutex> movableLock(_movableMutex);
+		pendingReleases.swap(_pendingReleases);
+		_movingMemories.clear();
+	}
+	for (auto& release : pendingReleases)
+	{
+		release();
 	}
 }
@@ -0,0 +1,116 @@
+#include "Graphic/Manager/OcclusionManager.h"
+#include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/Image.h"
+#include "Graphic/Command/CommandBuffer.h"
+#include "Graphic/Command/ImageMemoryBarrier.h"
+#include "Graphic/Core/Window.h"
+#include "Graphic/Core/Device.h"
+#include <Utils/Log.h>
+
+void Graphic::Manager::OcclusionManager::BuildDepthPyramid(const glm::mat4& viewProjection)
+{
+	//The frame that recorded the copy was waited for before this one started
+	if (_enable && _copied)
+	{
+		//Cached memory may not be coherent, atom aligned ranges stay inside the chunk since chunks are atom multiples
+		auto& memory = _readbackBuffer->Memory();
+		VkMappedMemoryRange range{};
+		range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+		range.memory = memory.VkMemory();
+		range.offset = memory.Offset() / _nonCoherentAtomSize * _nonCoherentAtomSize;
+		range.size = (memory.Offset() + memory.Size() - range.offset + _nonCoherentAtomSize - 1) / _nonCoherentAtomSize * _nonCoherentAtomSize;
+		Utils::Log::Exception("Failed to invalidate depth readback memory.", vkInvalidateMappedMemoryRanges(Core::Device::VkDevice_(), 1, &range));
+
+		_depthPyramid.Build(reinterpret_cast<const float*>(_readbackBuffer->Memory().MappedData()), _extent.width, _extent.height, _copiedViewProjection);
+	}
+	else
+	{
+		_depthPyramid.Invalidate();
+	}
+	_copied = false;
+	_viewProjection = viewProjection;
+}
+
+void Graphic::Manager::OcclusionManager::CopyDepth(Command::CommandBuffer* commandBuffer, Instance::Image* depthImage)
+{
+	if (!_enable) return;
+
+	//Attachment to transfer layout
+	{
+		Command::ImageMemoryBarrier depthReadBarrier = Command::ImageMemoryBarrier
+		(
+			depthImage,
+			VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+			VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT
+		);
+
+		commandBuffer->AddPipelineBarrier(
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT,
+			{ &depthReadBarrier }
+		);
+	}
+	commandBuffer->CopyImageToBuffer(depthImage, VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, _readbackBuffer);
+	//Transfer back to attachment layout for the later passes
+	{
+		Command::ImageMemoryBarrier depthAttachmentBarrier = Command::ImageMemoryBarrier
+		(
+			depthImage,
+			VkImageLayout::VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			VkImageLayout::VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+			VkAccessFlagBits::VK_ACCESS_TRANSFER_READ_BIT,
+			VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VkAccessFlagBits::VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+		);
+
+		commandBuffer->AddPipelineBarrier(
+			VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+			{ &depthAttachmentBarrier }
+		);
+	}
+	commandBuffer->AddPipelineBarrier(
+		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_TRANSFER_BIT, VkPipelineStageFlagBits::VK_PIPELINE_STAGE_HOST_BIT,
+		VkAccessFlagBits::VK_ACCESS_TRANSFER_WRITE_BIT, VkAccessFlagBits::VK_ACCESS_HOST_READ_BIT
+	);
+
+	_copied = true;
+	_copiedViewProjection = _viewProjection;
+}
+
+const Utils::DepthPyramid& Graphic::Manager::OcclusionManager::DepthPyramid()
+{
+	return _depthPyramid;
+}
+
+void Graphic::Manager::OcclusionManager::SetEnable(bool enable)
+{
+	_enable = enable;
+}
+
+bool Graphic::Manager::OcclusionManager::Enabled()
+{
+	return _enable;
+}
+
+Graphic::Manager::OcclusionManager::OcclusionManager()
+	: _readbackBuffer(nullptr)
+	, _extent(Core::Window::VkExtent2D_())
+	, _depthPyramid()
+	, _viewProjection(1.0f)
+	, _copiedViewProjection(1.0f)
+	, _copied(false)
+	, _enable(true)
+	, _nonCoherentAtomSize(1)
+{
+	VkPhysicalDeviceProperties properties{};
+	vkGetPhysicalDeviceProperties(Core::Device::VkPhysicalDevice_(), &properties);
+	_nonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
+
+	//The pyramid build reads all of it every frame, uncached write combined memory would stall every cull chunk behind it
+	_readbackBuffer = new Instance::Buffer(static_cast<size_t>(_extent.width) * _extent.height * sizeof(float), VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+}
+
+Graphic::Manager::OcclusionManager::~OcclusionManager()
+{
+	delete _readbackBuffer;
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Graphic/Manager/DescriptorSetManager.h"
 #include "Graphic/Core/Device.h"
 #include "Graphic/Instance/Buffer.h"
+#include "Graphic/Instance/RingBuffer.h"
 #include "Graphic/Instance/DescriptorSet.h"
 #include "Graphic/Instance/Image.h"
 #include "Graphic/Instance/ImageSampler.h"
@@ -22,6 +23,8 @@ Graphic::Material::Material(Asset::Shader* shader)
 		newSlot.slotType = pair.second.slotType;
 		newSlot.descriptorSet = Core::Device::DescriptorSetManager().AcquireDescripterSet(pair.second.slotType, pair.second.descriptorSetLayout);
 		newSlot.set = pair.second.set;
+		newSlot.dynamicOffset = 0;
+		newSlot.bufferVersion = 0;
 		_slots.emplace(newSlot.name, newSlot);
 	}
 }
@@ -132,6 +135,86 @@ void Graphic::Material::SetUniformBuffer(const char* name, Graphic::Instance::Bu
 	}
 }
 
+const Graphic::Instance::Buffer* Graphic::Material::GetStorageBuffer(const char* name)
+{
+	if (_slots.count(name) && _slots[name].slotType == Asset::SlotType::STORAGE_BUFFER)
+	{
+		return static_cast<const Graphic::Instance::Buffer*>(_slots[name].asset);
+	}
+	else
+	{
+		Utils::Log::Exception("Failed to get storage buffer.");
+	}
+}
+
+void Graphic::Material::SetStorageBuffer(const char* name, Graphic::Instance::Buffer* buffer)
+{
+	if (_slots.count(name) && _slots[name].slotType == Asset::SlotType::STORAGE_BUFFER)
+	{
+		_slots[name].asset = buffer;
+		_slots[name].descriptorSet->UpdateBindingData(
+			{ 0 },
+			{
+				{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffer->VkBuffer_(), 0, buffer->Size()}
+			}
+			);
+	}
+	else
+	{
+		Utils::Log::Exception("Failed to set storage buffer.");
+	}
+}
+
+void Graphic::Material::SetUniformBuffer(const char* name, Graphic::Instance::RingBuffer* ringBuffer, uint32_t dynamicOffset)
+{
+	if (_slots.count(name) && _slots[name].slotType == Asset::SlotType::UNIFORM_BUFFER_DYNAMIC)
+	{
+		auto& slot = _slots[name];
+		//Only the offset changes per frame, the descriptor is rewritten when the ring is recreated
+		if (slot.asset != ringBuffer || slot.bufferVersion != ringBuffer->Version())
+		{
+			slot.asset = ringBuffer;
+			slot.bufferVersion = ringBuffer->Version();
+			slot.descriptorSet->UpdateBindingData(
+				{ 0 },
+				{
+					{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, ringBuffer->VkBuffer_(), 0, ringBuffer->Range()}
+				}
+				);
+		}
+		slot.dynamicOffset = dynamicOffset;
+	}
+	else
+	{
+		Utils::Log::Exception("Failed to set dynamic uniform buffer.");
+	}
+}
+
+void Graphic::Material::SetStorageBuffer(const char* name, Graphic::Instance::RingBuffer* ringBuffer, uint32_t dynamicOffset)
+{
+	if (_slots.count(name) && _slots[name].slotType == Asset::SlotType::STORAGE_BUFFER_DYNAMIC)
+	{
+		auto& slot = _slots[name];
+		//Only the offset changes per frame, the descriptor is rewritten when the ring is recreated
+		if (slot.asset != ringBuffer || slot.bufferVersion != ringBuffer->Version())
+		{
+			slot.asset = ringBuffer;
+			slot.bufferVersion = ringBuffer->Version();
+			slot.descriptorSet->UpdateBindingData(
+				{ 0 },
+				{
+					{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, ringBuffer->VkBuffer_(), 0, ringBuffer->Range()}
+				}
+				);
+		}
+		slot.dynamicOffset = dynamicOffset;
+	}
+	else
+	{
+		Utils::Log::Exception("Failed to set dynamic storage buffer.");
+	}
+}
+
 void Graphic::Material::RefreshSlotData(std::vector<std::string> slotNames)
 {
 	for (const auto& slotName : slotNames)
@@ -145,6 +228,24 @@ void Graphic::Material::RefreshSlotData(std::vector<std::string> slotNames)
 			slot.descriptorSet->UpdateBindingData({ 0 }, { Graphic::Instance::DescriptorSet::DescriptorSetWriteData(VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, ub->VkBuffer_(), 0, ub->Size()) });
 			break;
 		}
+		case Asset::SlotType::STORAGE_BUFFER:
+		{
+			Instance::Buffer* sb = static_cast<Instance::Buffer*>(slot.asset);
+			slot.descriptorSet->UpdateBindingData({ 0 }, { Graphic::Instance::DescriptorSet::DescriptorSetWriteData(VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sb->VkBuffer_(), 0, sb->Size()) });
+			break;
+		}
+		case Asset::SlotType::UNIFORM_BUFFER_DYNAMIC:
+		{
+			Instance::RingBuffer* rb = static_cast<Instance::RingBuffer*>(slot.asset);
+			slot.descriptorSet->UpdateBindingData({ 0 }, { Graphic::Instance::DescriptorSet::DescriptorSetWriteData(VkDescriptorType::VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, rb->VkBuffer_(), 0, rb->Range()) });
+			break;
+		}
+		case Asset::SlotType::STORAGE_BUFFER_DYNAMIC:
+		{
+			Instance::RingBuffer* rb = static_cast<Instance::RingBuffer*>(slot.asset);
+			slot.descriptorSet->UpdateBindingData({ 0 }, { Graphic::Instance::DescriptorSet::DescriptorSetWriteData(VkDescriptorType::VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, rb->VkBuffer_(), 0, rb->Range()) });
+			break;
+		}
 		case Asset::SlotType::TEXTURE2D:
 		{
 			Graphic::Asset::Texture2D* t = static_cast<Asset::Texture2D*>(slot.asset);
@@ -182,6 +283,27 @@ std::vector<VkDescriptorSet> Graphic::Material::DescriptorSets()
 	return sets;
 }
 
+std::vector<uint32_t> Graphic::Material::DynamicOffsets()
+{
+	//Ordered by set, each slot has a single binding
+	std::map<uint32_t, uint32_t> setOffsets = std::map<uint32_t, uint32_t>();
+	for (const auto& slotPair : _slots)
+	{
+		if (slotPair.second.slotType == Asset::SlotType::UNIFORM_BUFFER_DYNAMIC || slotPair.second.slotType == Asset::SlotType::STORAGE_BUFFER_DYNAMIC)
+		{
+			setOffsets[slotPair.second.set] = slotPair.second.dynamicOffset;
+		}
+	}
+
+	std::vector<uint32_t> offsets = std::vector<uint32_t>();
+	offsets.reserve(setOffsets.size());
+	for (const auto& setOffsetPair : setOffsets)
+	{
+		offsets.emplace_back(setOffsetPair.second);
+	}
+	return offsets;
+}
+
 Graphic::Asset::Shader& Graphic::Material::Shader()
 {
 	return *_shader;
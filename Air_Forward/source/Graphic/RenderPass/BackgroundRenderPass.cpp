@@ -62,7 +62,7 @@ void Graphic::RenderPass::BackgroundRenderPass::OnPrepare()
 	);
 }
 
-void Graphic::RenderPass::BackgroundRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable)
+void Graphic::RenderPass::BackgroundRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList)
 {
 	_renderCommandPool = commandPool;
 	_renderCommandBuffer = commandPool->CreateCommandBuffer("BackgroundCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
@@ -71,9 +71,10 @@ void Graphic::RenderPass::BackgroundRenderPass::OnPopulateCommandBuffer(Command:
 	//Render
 	_renderCommandBuffer->Reset();
 	_renderCommandBuffer->BeginRecord(VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
-	if (renderDistanceTable.size() >= 1)
+	if (drawList.BatchCount() >= 1)
 	{
-		auto renderer = renderDistanceTable.begin()->second;
+		const auto& drawBatch = drawList.Batch(0);
+		auto renderer = drawBatch.rendererProxy;
 
 		renderer->material->SetSlotData("depthTexture", { 0 }, { {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, _temporaryImageSampler->VkSampler_(), _temporaryImage->VkImageView_(), VkImageLayout::VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL} });
 
@@ -154,11 +155,11 @@ void Graphic::RenderPass::BackgroundRenderPass::OnPopulateCommandBuffer(Command:
 		_renderCommandBuffer->BindShader(&renderer->material->Shader());
 		_renderCommandBuffer->BindMesh(renderer->mesh);
 		_renderCommandBuffer->BindMaterial(renderer->material);
-		_renderCommandBuffer->Draw();
+		_renderCommandBuffer->Draw(drawBatch.instanceCount, drawBatch.firstInstance);
 		_renderCommandBuffer->EndRenderPass();
 
 	}
-	if (renderDistanceTable.size() > 1)
+	if (drawList.Size() > 1)
 	{
 		Utils::Log::Exception("Contains multiple background renderer.");
 	}
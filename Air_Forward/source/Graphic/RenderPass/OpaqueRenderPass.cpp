@@ -2,12 +2,17 @@
 #include "Graphic/Command/CommandBuffer.h"
 #include "Graphic/Command/CommandPool.h"
 #include "Graphic/Core/Device.h"
+#include "Graphic/Core/Thread.h"
 #include "Graphic/Manager/FrameBufferManager.h"
 #include "Graphic/Core/Window.h"
 #include "Graphic/Command/ImageMemoryBarrier.h"
 #include "Graphic/Instance/FrameBuffer.h"
 #include "Logic/Component/Renderer/Renderer.h"
 #include "Graphic/Material.h"
+#include "Graphic/Core/Instance.h"
+#include "Graphic/Manager/OcclusionManager.h"
+#include "Utils/Log.h"
+#include <algorithm>
 
 void Graphic::RenderPass::OpaqueRenderPass::OnCreate(Graphic::Manager::RenderPassManager::RenderPassCreator& creator)
 {
@@ -67,10 +72,29 @@ void Graphic::RenderPass::OpaqueRenderPass::OnPrepare()
 	_frameBuffer = Core::Device::FrameBufferManager().FrameBuffer("OpaqueFrameBuffer");
 }
 
-void Graphic::RenderPass::OpaqueRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable)
+void Graphic::RenderPass::OpaqueRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList)
 {
 	_renderCommandPool = commandPool;
 
+	//Record draw chunks on other sub render threads
+	const size_t batchCount = drawList.BatchCount();
+	const size_t chunkCount = std::min(Core::Thread::SubRenderThreadCount(), (batchCount + MIN_CHUNK_BATCH_COUNT - 1) / MIN_CHUNK_BATCH_COUNT);
+	const size_t chunkSize = chunkCount == 0 ? 0 : (batchCount + chunkCount - 1) / chunkCount;
+	const uint32_t subpassIndex = SubPassIndex("DrawSubpass");
+	_chunkCommandBuffers.assign(chunkCount, nullptr);
+	_chunkCommandPools.assign(chunkCount, nullptr);
+	std::vector<std::future<Command::CommandBuffer*>> chunkTasks = std::vector<std::future<Command::CommandBuffer*>>();
+	for (size_t chunkIndex = 1; chunkIndex < chunkCount; chunkIndex++)
+	{
+		chunkTasks.emplace_back(Core::Thread::AddRenderTask([this, &drawList, subpassIndex, chunkIndex, chunkSize](Command::CommandPool* chunkCommandPool) {
+			return _RecordChunk(chunkCommandPool, drawList, subpassIndex, chunkIndex, chunkSize);
+		}));
+	}
+	if (chunkCount > 0)
+	{
+		_RecordChunk(commandPool, drawList, subpassIndex, 0, chunkSize);
+	}
+
 	_renderCommandBuffer = commandPool->CreateCommandBuffer("OpaqueCommandBuffer", VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 	_renderCommandBuffer->Reset();
 
@@ -115,20 +139,60 @@ void Graphic::RenderPass::OpaqueRenderPass::OnPopulateCommandBuffer(Command::Com
 	_renderCommandBuffer->BeginRenderPass(
 		this,
 		_frameBuffer,
-		{ colorClearValue, depthClearValue }
+		{ colorClearValue, depthClearValue },
+		VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
 	);
-	for (const auto& rendererDistencePair : renderDistanceTable)
+	for (auto& chunkTask : chunkTasks)
 	{
-		auto& renderer = rendererDistencePair.second;
-
-		_renderCommandBuffer->BindShader(&renderer->material->Shader());
-		_renderCommandBuffer->BindMesh(renderer->mesh);
-		_renderCommandBuffer->BindMaterial(renderer->material);
-		_renderCommandBuffer->Draw();
+		chunkTask.get();
 	}
+	_renderCommandBuffer->ExecuteCommands(_chunkCommandBuffers);
 	_renderCommandBuffer->EndRenderPass();
+	//Only opaque geometry occludes, so depth is read back before the later passes draw
+	Core::Instance::occlusionManager->CopyDepth(_renderCommandBuffer, &_depthAttachment->Image());
 	_renderCommandBuffer->EndRecord();
 
+	Command::CommandBuffer::BindStatistics statistics = Command::CommandBuffer::BindStatistics();
+	for (const auto& chunkCommandBuffer : _chunkCommandBuffers)
+	{
+		statistics.pipelineSkipCount += chunkCommandBuffer->Statistics().pipelineSkipCount;
+		statistics.meshSkipCount += chunkCommandBuffer->Statistics().meshSkipCount;
+		statistics.descriptorSetSkipCount += chunkCommandBuffer->Statistics().descriptorSetSkipCount;
+	}
+	Utils::Log::Message(
+		"Graphic::RenderPass::OpaqueRenderPass skip " + std::to_string(statistics.pipelineSkipCount) + " pipeline, "
+		+ std::to_string(statistics.meshSkipCount) + " mesh and "
+		+ std::to_string(statistics.descriptorSetSkipCount) + " descriptor set binds of " + std::to_string(drawList.BatchCount()) + " draws for " + std::to_string(drawList.Size()) + " renderers in " + std::to_string(chunkCount) + " chunks."
+	);
+}
+
+Graphic::Command::CommandBuffer* Graphic::RenderPass::OpaqueRenderPass::_RecordChunk(Command::CommandPool* commandPool, Core::DrawList& drawList, uint32_t subpassIndex, size_t chunkIndex, size_t chunkSize)
+{
+	auto chunkCommandBuffer = commandPool->CreateCommandBuffer("OpaqueChunkCommandBuffer" + std::to_string(chunkIndex), VkCommandBufferLevel::VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+	chunkCommandBuffer->BeginRecord(VkCommandBufferUsageFlagBits::VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, this, subpassIndex, _frameBuffer);
+	const size_t chunkEnd = std::min(drawList.BatchCount(), (chunkIndex + 1) * chunkSize);
+	for (size_t i = chunkIndex * chunkSize; i < chunkEnd; i++)
+	{
+		const auto& drawBatch = drawList.Batch(i);
+		auto renderer = drawBatch.rendererProxy;
+
+		chunkCommandBuffer->BindShader(&renderer->material->Shader());
+		chunkCommandBuffer->BindMesh(renderer->mesh);
+		chunkCommandBuffer->BindMaterial(renderer->material);
+		chunkCommandBuffer->Draw(drawBatch.instanceCount, drawBatch.firstInstance);
+	}
+	chunkCommandBuffer->EndRecord();
+
+	//Every chunk owns its own slot
+	_chunkCommandBuffers[chunkIndex] = chunkCommandBuffer;
+	_chunkCommandPools[chunkIndex] = commandPool;
+	return chunkCommandBuffer;
+
+}
+
+Graphic::Core::DrawList::SortMode Graphic::RenderPass::OpaqueRenderPass::DrawListSortMode()
+{
+	return Core::DrawList::SortMode::STATE_MAJOR;
 }
 
 void Graphic::RenderPass::OpaqueRenderPass::OnRender()
@@ -139,12 +203,20 @@ void Graphic::RenderPass::OpaqueRenderPass::OnRender()
 void Graphic::RenderPass::OpaqueRenderPass::OnClear()
 {
 	_renderCommandPool->DestoryCommandBuffer("OpaqueCommandBuffer");
+	for (size_t i = 0; i < _chunkCommandBuffers.size(); i++)
+	{
+		_chunkCommandPools[i]->DestoryCommandBuffer(_chunkCommandBuffers[i]->_name);
+	}
+	_chunkCommandBuffers.clear();
+	_chunkCommandPools.clear();
 }
 
 Graphic::RenderPass::OpaqueRenderPass::OpaqueRenderPass()
 	: RenderPass("OpaqueRenderPass", 2000)
 	, _renderCommandBuffer(nullptr)
 	, _renderCommandPool(nullptr)
+	, _chunkCommandBuffers()
+	, _chunkCommandPools()
 	, _frameBuffer(nullptr)
 	, _colorAttachment(nullptr)
 	, _depthAttachment(nullptr)
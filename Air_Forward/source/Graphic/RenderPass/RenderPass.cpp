@@ -16,6 +16,11 @@ Graphic::RenderPass::RenderPass::RenderPass(std::string name, uint32_t renderInd
 	_semaphore = new Command::Semaphore();
 }
 
+Graphic::Core::DrawList::SortMode Graphic::RenderPass::RenderPass::DrawListSortMode()
+{
+	return Core::DrawList::SortMode::DEPTH_MAJOR;
+}
+
 Graphic::RenderPass::RenderPass::~RenderPass()
 {
 
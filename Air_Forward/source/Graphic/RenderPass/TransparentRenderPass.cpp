@@ -61,7 +61,7 @@ void Graphic::RenderPass::TransparentRenderPass::OnPrepare()
 	_frameBuffer = Core::Device::FrameBufferManager().FrameBuffer("TransparentFrameBuffer");
 }
 
-void Graphic::RenderPass::TransparentRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, std::multimap<float, Logic::Component::Renderer::Renderer*>& renderDistanceTable)
+void Graphic::RenderPass::TransparentRenderPass::OnPopulateCommandBuffer(Command::CommandPool* commandPool, Core::DrawList& drawList)
 {
 	_renderCommandPool = commandPool;
 
@@ -86,14 +86,15 @@ void Graphic::RenderPass::TransparentRenderPass::OnPopulateCommandBuffer(Command
 		VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
 		VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
 	);
-	for (auto iter = renderDistanceTable.rbegin(); iter != renderDistanceTable.rend(); iter++)
+	for (size_t i = drawList.BatchCount(); i > 0; i--)
 	{
-		auto& renderer = iter->second;
+		const auto& drawBatch = drawList.Batch(i - 1);
+		auto renderer = drawBatch.rendererProxy;
 
 		_renderCommandBuffer->BindShader(&renderer->material->Shader());
 		_renderCommandBuffer->BindMesh(renderer->mesh);
 		_renderCommandBuffer->BindMaterial(renderer->material);
-		_renderCommandBuffer->Draw();
+		_renderCommandBuffer->Draw(drawBatch.instanceCount, drawBatch.firstInstance);
 
 		_renderCommandBuffer->AddPipelineBarrier(
 			VkDependencyFlagBits::VK_DEPENDENCY_BY_REGION_BIT,
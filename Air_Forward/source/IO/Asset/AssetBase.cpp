@@ -11,7 +11,11 @@ IO::Asset::IAsset::~IAsset()
 
 IO::Asset::IAssetInstance::IAssetInstance(std::string path)
 	: path(path)
+	, _readyMutex()
 	, _readyToUse(false)
+	, _loadException()
+	, _readyCallbacks()
+	, _pathId(0)
 {
 }
 
@@ -6,19 +6,30 @@
 #include <glm/glm.hpp>
 #include "Graphic/Command/CommandPool.h"
 #include "Graphic/Command/CommandBuffer.h"
+#include "Graphic/Instance/StagingBuffer.h"
 
+Utils::JobSystem<IO::Core::UploadBatcher*> IO::Core::Thread::_jobSystem(4);
 IO::Core::Thread::LoadThread IO::Core::Thread::_loadThread = IO::Core::Thread::LoadThread();
-std::queue<std::function<void(Graphic::Command::CommandBuffer* const)>> IO::Core::Thread::_tasks = std::queue<std::function<void(Graphic::Command::CommandBuffer* const)>>();
-std::mutex IO::Core::Thread::_queueMutex = std::mutex();
-std::condition_variable IO::Core::Thread::_queueVariable = std::condition_variable();
+thread_local IO::Core::UploadBatcher* IO::Core::Thread::_currentUploadBatcher = nullptr;
+
+IO::Core::UploadBatcher& IO::Core::Thread::CurrentUploadBatcher()
+{
+	Utils::Log::Exception("Upload batcher is only available on load threads.", _currentUploadBatcher == nullptr);
+	return *_currentUploadBatcher;
+}
+
+Graphic::Instance::StagingBuffer& IO::Core::Thread::StagingBuffer()
+{
+	return CurrentUploadBatcher().StagingBuffer();
+}
 
 void IO::Core::Thread::LoadThread::Init()
 {
 	_stopped = true;
-	_subLoadThreads.emplace_back(new SubLoadThread());
-	_subLoadThreads.emplace_back(new SubLoadThread());
-	_subLoadThreads.emplace_back(new SubLoadThread());
-	_subLoadThreads.emplace_back(new SubLoadThread());
+	for (uint32_t i = 0; i < _jobSystem.WorkerCount(); i++)
+	{
+		_subLoadThreads.emplace_back(new SubLoadThread(i));
+	}
 	for (auto& subThread : _subLoadThreads)
 	{
 		subThread->Init();
@@ -51,6 +62,7 @@ void IO::Core::Thread::LoadThread::OnRun()
 void IO::Core::Thread::LoadThread::OnEnd()
 {
 	_stopped = true;
+	_jobSystem.Stop();
 
 	for (auto& subLoadThread : _subLoadThreads)
 	{
@@ -71,9 +83,11 @@ IO::Core::Thread::LoadThread::~LoadThread()
 }
 
 
-IO::Core::Thread::SubLoadThread::SubLoadThread()
+IO::Core::Thread::SubLoadThread::SubLoadThread(uint32_t workerIndex)
 	: _transferCommandPool(nullptr)
-	, _transferCommandBuffer(nullptr)
+	, _acquireCommandPool(nullptr)
+	, _uploadBatcher(nullptr)
+	, _workerIndex(workerIndex)
 {
 }
 
@@ -85,7 +99,9 @@ IO::Core::Thread::SubLoadThread::~SubLoadThread()
 void IO::Core::Thread::SubLoadThread::Init()
 {
 	_transferCommandPool = new Graphic::Command::CommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, "TransferQueue");
-	_transferCommandBuffer = _transferCommandPool->CreateCommandBuffer("TransferCommandBuffer", VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+	//Uploaded resources are handed over to the render queue family
+	_acquireCommandPool = new Graphic::Command::CommandPool(VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, "RenderQueue");
+	_uploadBatcher = new UploadBatcher(_transferCommandPool, _acquireCommandPool, "TransferCommandBuffer", 3, 8 * 1024 * 1024);
 
 }
 void IO::Core::Thread::SubLoadThread::OnStart()
@@ -95,23 +111,16 @@ void IO::Core::Thread::SubLoadThread::OnStart()
 
 void IO::Core::Thread::SubLoadThread::OnRun()
 {
-	while (true)
-	{
-		std::function<void(Graphic::Command::CommandBuffer* const)> task;
-
-		{
-			std::unique_lock<std::mutex> lock(_queueMutex);
-			_queueVariable.wait(lock, [this] { return _loadThread._stopped || !_tasks.empty(); });
-			if (_loadThread._stopped && _tasks.empty())
-			{
-				return;
-			}
-			task = std::move(_tasks.front());
-			_tasks.pop();
-		}
-
-		task(_transferCommandBuffer);
-	}
+	//Pending uploads are submitted as soon as the worker runs out of tasks
+	_currentUploadBatcher = _uploadBatcher;
+	_jobSystem.RunWorker(_workerIndex, _uploadBatcher, [this]() {
+		return _uploadBatcher->Poll();
+	});
+	_currentUploadBatcher = nullptr;
+
+	//Every upload has finished once the worker returns
+	delete _uploadBatcher;
+	_uploadBatcher = nullptr;
 }
 
 void IO::Core::Thread::SubLoadThread::OnEnd()
@@ -0,0 +1,190 @@
+#include "IO/Core/UploadBatcher.h"
+#include "Graphic/Command/CommandPool.h"
+#include "Graphic/Command/CommandBuffer.h"
+#include "Graphic/Instance/StagingBuffer.h"
+#include "Graphic/Core/Device.h"
+
+IO::Core::UploadBatcher::UploadBatcher(Graphic::Command::CommandPool* commandPool, Graphic::Command::CommandPool* acquireCommandPool, std::string name, uint32_t batchCount, VkDeviceSize stagingSize)
+	: _commandPool(commandPool)
+	, _acquireCommandPool(acquireCommandPool)
+	, _name(name)
+	, _transferQueueFamilyIndex(Graphic::Core::Device::Queue_(commandPool->QueueName()).QueueFamilyIndex())
+	, _renderQueueFamilyIndex(Graphic::Core::Device::Queue_(acquireCommandPool->QueueName()).QueueFamilyIndex())
+	, _batches(batchCount)
+	, _currentBatch(0)
+{
+	for (uint32_t i = 0; i < batchCount; i++)
+	{
+		auto& batch = _batches[i];
+		batch.commandBuffer = _commandPool->CreateCommandBuffer(_name + std::to_string(i), VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		batch.acquireCommandBuffer = _acquireCommandPool->CreateCommandBuffer(_name + "Acquire" + std::to_string(i), VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		batch.stagingBuffer = new Graphic::Instance::StagingBuffer(stagingSize);
+		batch.uploadCount = 0;
+		batch.inFlight = false;
+	}
+	_Begin(_currentBatch);
+}
+
+IO::Core::UploadBatcher::~UploadBatcher()
+{
+	WaitAll();
+	_batches[_currentBatch].commandBuffer->EndRecord();
+	for (uint32_t i = 0; i < _batches.size(); i++)
+	{
+		_batches[i].acquireCommandBuffer->WaitForFinish();
+		_commandPool->DestoryCommandBuffer(_name + std::to_string(i));
+		_acquireCommandPool->DestoryCommandBuffer(_name + "Acquire" + std::to_string(i));
+		delete _batches[i].stagingBuffer;
+	}
+}
+
+Graphic::Command::CommandBuffer* IO::Core::UploadBatcher::CommandBuffer()
+{
+	return _batches[_currentBatch].commandBuffer;
+}
+
+Graphic::Instance::StagingBuffer& IO::Core::UploadBatcher::StagingBuffer()
+{
+	return *_batches[_currentBatch].stagingBuffer;
+}
+
+void IO::Core::UploadBatcher::OnFinish(std::function<void()> callback)
+{
+	_batches[_currentBatch].finishCallbacks.emplace_back(callback);
+}
+
+void IO::Core::UploadBatcher::TransferOwnership(Graphic::Instance::Image* image, VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags dstAccessFlags)
+{
+	auto& batch = _batches[_currentBatch];
+	if (_transferQueueFamilyIndex == _renderQueueFamilyIndex)
+	{
+		Graphic::Command::ImageMemoryBarrier barrier = Graphic::Command::ImageMemoryBarrier(image, oldLayout, newLayout, VK_ACCESS_TRANSFER_WRITE_BIT, 0);
+		batch.commandBuffer->AddPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, { &barrier });
+		return;
+	}
+
+	//Release and acquire must describe the same layout transition
+	Graphic::Command::ImageMemoryBarrier releaseBarrier = Graphic::Command::ImageMemoryBarrier(image, oldLayout, newLayout, VK_ACCESS_TRANSFER_WRITE_BIT, 0, _transferQueueFamilyIndex, _renderQueueFamilyIndex);
+	batch.commandBuffer->AddPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, { &releaseBarrier });
+	batch.acquireImageBarriers.emplace_back(image, oldLayout, newLayout, 0, dstAccessFlags, _transferQueueFamilyIndex, _renderQueueFamilyIndex);
+}
+
+void IO::Core::UploadBatcher::TransferOwnership(Graphic::Instance::Buffer* buffer, VkAccessFlags dstAccessFlags)
+{
+	if (_transferQueueFamilyIndex == _renderQueueFamilyIndex) return;
+
+	auto& batch = _batches[_currentBatch];
+	Graphic::Command::BufferMemoryBarrier releaseBarrier = Graphic::Command::BufferMemoryBarrier(buffer, VK_ACCESS_TRANSFER_WRITE_BIT, 0, _transferQueueFamilyIndex, _renderQueueFamilyIndex);
+	batch.commandBuffer->AddPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, {}, { &releaseBarrier });
+	batch.acquireBufferBarriers.emplace_back(buffer, 0, dstAccessFlags, _transferQueueFamilyIndex, _renderQueueFamilyIndex);
+}
+
+void IO::Core::UploadBatcher::EndUpload()
+{
+	auto& batch = _batches[_currentBatch];
+	batch.uploadCount++;
+	if (batch.uploadCount >= MAX_UPLOAD_COUNT || batch.stagingBuffer->Used() >= FLUSH_SIZE) Flush();
+}
+
+void IO::Core::UploadBatcher::Flush()
+{
+	auto& batch = _batches[_currentBatch];
+	if (batch.uploadCount == 0 && batch.finishCallbacks.empty()) return;
+
+	batch.commandBuffer->EndRecord();
+	batch.commandBuffer->Submit({}, {}, {});
+	batch.inFlight = true;
+
+	_currentBatch = (_currentBatch + 1) % _batches.size();
+	_Begin(_currentBatch);
+}
+
+bool IO::Core::UploadBatcher::Poll()
+{
+	Flush();
+
+	bool inFlight = false;
+	for (uint32_t i = 0; i < _batches.size(); i++)
+	{
+		if (!_batches[i].inFlight) continue;
+		if (_batches[i].commandBuffer->Finished())
+		{
+			_Finish(i);
+		}
+		else
+		{
+			inFlight = true;
+		}
+	}
+	return inFlight;
+}
+
+void IO::Core::UploadBatcher::WaitAll()
+{
+	Flush();
+	for (uint32_t i = 0; i < _batches.size(); i++)
+	{
+		if (!_batches[i].inFlight) continue;
+		_batches[i].commandBuffer->WaitForFinish();
+		_Finish(i);
+	}
+}
+
+void IO::Core::UploadBatcher::_Begin(uint32_t batchIndex)
+{
+	auto& batch = _batches[batchIndex];
+
+	//Every batch is in flight, wait for the oldest one to reuse it
+	if (batch.inFlight)
+	{
+		batch.commandBuffer->WaitForFinish();
+		_Finish(batchIndex);
+	}
+
+	batch.stagingBuffer->Reset();
+	batch.commandBuffer->Reset();
+	batch.commandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+}
+
+void IO::Core::UploadBatcher::_Finish(uint32_t batchIndex)
+{
+	auto& batch = _batches[batchIndex];
+	batch.inFlight = false;
+	batch.uploadCount = 0;
+	_Acquire(batchIndex);
+
+	std::vector<std::function<void()>> finishCallbacks;
+	finishCallbacks.swap(batch.finishCallbacks);
+	for (auto& callback : finishCallbacks)
+	{
+		callback();
+	}
+}
+
+void IO::Core::UploadBatcher::_Acquire(uint32_t batchIndex)
+{
+	auto& batch = _batches[batchIndex];
+	if (batch.acquireImageBarriers.empty() && batch.acquireBufferBarriers.empty()) return;
+
+	std::vector<Graphic::Command::ImageMemoryBarrier*> imageBarriers = std::vector<Graphic::Command::ImageMemoryBarrier*>();
+	for (auto& barrier : batch.acquireImageBarriers)
+	{
+		imageBarriers.emplace_back(&barrier);
+	}
+	std::vector<Graphic::Command::BufferMemoryBarrier*> bufferBarriers = std::vector<Graphic::Command::BufferMemoryBarrier*>();
+	for (auto& barrier : batch.acquireBufferBarriers)
+	{
+		bufferBarriers.emplace_back(&barrier);
+	}
+
+	//The release has finished on the transfer queue, later render submissions are ordered behind the acquire
+	batch.acquireCommandBuffer->WaitForFinish();
+	batch.acquireCommandBuffer->Reset();
+	batch.acquireCommandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	batch.acquireCommandBuffer->AddPipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, imageBarriers, bufferBarriers);
+	batch.acquireCommandBuffer->EndRecord();
+	batch.acquireCommandBuffer->Submit({}, {}, {});
+
+	batch.acquireImageBarriers.clear();
+	batch.acquireBufferBarriers.clear();
+}
\ No newline at end of file
@@ -1,77 +1,249 @@
 #include "IO/Manager/AssetManager.h"
 #include "IO/Asset/AssetBase.h"
 #include "Utils/Log.h"
+#include <algorithm>
 #include <vector>
 #include <string>
 IO::Manager::AssetManager::AssetManager()
-	: _warps()
-	, _managerMutex()
+	: _shards()
+	, _unusedTick(0)
+	, _budgetMutex()
+	, _budgets()
+	, _unusedSizes()
 {
+	for (auto& shard : _shards)
+	{
+		shard.unusedHead = NULL_INDEX;
+	}
 }
 
 IO::Manager::AssetManager::~AssetManager()
 {
-	std::unique_lock<std::mutex> lock(_managerMutex);
-	for (const auto& pair : _warps)
+	for (auto& shard : _shards)
 	{
-		for (const auto& asset : pair.second.assets)
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		for (const auto& pathIndex : shard.pathIndexs)
 		{
-			delete asset;
+			auto& warp = shard.warps[pathIndex.second];
+			for (const auto& asset : warp.assets)
+			{
+				delete asset;
+			}
+			delete warp.assetInstance;
 		}
-		delete pair.second.assetInstance;
+		shard.pathIndexs.clear();
+		shard.warps.clear();
+		shard.freeIndexs.clear();
+		shard.unusedHead = NULL_INDEX;
 	}
-	_warps.clear();
 }
 
 void IO::Manager::AssetManager::Collect()
 {
-	std::unique_lock<std::mutex> lock(_managerMutex);
 	std::vector<std::string> collecteds;
-	for (auto it = _warps.cbegin(); it != _warps.cend(); )
+
+	//Only unreferenced instances are visited, failed loads go right away
+	std::unordered_map<std::type_index, std::vector<_EvictionCandidate>> candidates;
+	for (uint32_t shardIndex = 0; shardIndex < SHARD_COUNT; shardIndex++)
 	{
-		if (it->second.refCount == 0)
+		auto& shard = _shards[shardIndex];
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		uint32_t index = shard.unusedHead;
+		while (index != NULL_INDEX)
 		{
-			collecteds.push_back(it->second.assetInstance->path);
-			for (const auto& asset : it->second.assets)
+			auto& warp = shard.warps[index];
+			uint32_t nextIndex = warp.nextUnused;
+			//Loads still in flight reference their instance
+			if (warp.assetInstance->_Ready())
 			{
-				delete asset;
+				if (warp.assetInstance->_loadException)
+				{
+					collecteds.push_back(warp.assetInstance->path);
+					_Evict(shard, index);
+				}
+				else
+				{
+					candidates[warp.assetType].push_back({ shardIndex, index, warp.unusedTick, warp.assetInstance->_ResidentSize() });
+				}
 			}
-			delete it->second.assetInstance;
-			it = _warps.erase(it++);
+			index = nextIndex;
 		}
-		else
+	}
+
+	std::unordered_map<std::type_index, size_t> budgets;
+	{
+		std::unique_lock<std::mutex> lock(_budgetMutex);
+		budgets = _budgets;
+	}
+	std::unordered_map<std::type_index, size_t> unusedSizes;
+	for (auto& typeCandidates : candidates)
+	{
+		auto budgetIterator = budgets.find(typeCandidates.first);
+		size_t budget = budgetIterator == budgets.end() ? 0 : budgetIterator->second;
+		size_t unusedSize = 0;
+		for (const auto& candidate : typeCandidates.second)
 		{
-			++it;
+			unusedSize += candidate.size;
 		}
+
+		//Least recently released first
+		auto& typeCandidateList = typeCandidates.second;
+		std::sort(typeCandidateList.begin(), typeCandidateList.end(), [](const _EvictionCandidate& a, const _EvictionCandidate& b) {
+			return a.unusedTick < b.unusedTick;
+		});
+		for (const auto& candidate : typeCandidateList)
+		{
+			if (unusedSize <= budget && budget > 0) break;
+
+			auto& shard = _shards[candidate.shardIndex];
+			std::unique_lock<std::mutex> lock(shard.mutex);
+			auto& warp = shard.warps[candidate.index];
+			//Acquired again since the scan
+			if (warp.unused && warp.unusedTick == candidate.unusedTick)
+			{
+				collecteds.push_back(warp.assetInstance->path);
+				shard.counters[warp.assetType].evictionCount++;
+				_Evict(shard, candidate.index);
+			}
+			unusedSize -= candidate.size;
+		}
+		unusedSizes[typeCandidates.first] = unusedSize;
+	}
+	{
+		std::unique_lock<std::mutex> lock(_budgetMutex);
+		_unusedSizes = unusedSizes;
 	}
+
 	for (const auto& collected : collecteds)
 	{
 		Utils::Log::Message("AssetManager collect " + collected + " .");
 	}
 }
 
-void IO::Manager::AssetManager::_AddInstance(std::string path, IO::Asset::IAssetInstance* assetInstance)
+void IO::Manager::AssetManager::SetBudget(std::type_index assetType, size_t budget)
+{
+	std::unique_lock<std::mutex> lock(_budgetMutex);
+	_budgets[assetType] = budget;
+}
+
+IO::Manager::AssetManager::CacheStatistics IO::Manager::AssetManager::Statistics(std::type_index assetType)
+{
+	CacheStatistics statistics{};
+	for (auto& shard : _shards)
+	{
+		std::unique_lock<std::mutex> lock(shard.mutex);
+		auto iterator = shard.counters.find(assetType);
+		if (iterator == shard.counters.end()) continue;
+		statistics.hitCount += iterator->second.hitCount;
+		statistics.missCount += iterator->second.missCount;
+		statistics.evictionCount += iterator->second.evictionCount;
+	}
+	{
+		std::unique_lock<std::mutex> lock(_budgetMutex);
+		auto unusedSizeIterator = _unusedSizes.find(assetType);
+		if (unusedSizeIterator != _unusedSizes.end()) statistics.unusedSize = unusedSizeIterator->second;
+		auto budgetIterator = _budgets.find(assetType);
+		if (budgetIterator != _budgets.end()) statistics.budget = budgetIterator->second;
+	}
+	return statistics;
+}
+
+uint32_t IO::Manager::AssetManager::_ShardIndex(const std::string& path)
+{
+	return static_cast<uint32_t>(std::hash<std::string>()(path) % SHARD_COUNT);
+}
+
+void IO::Manager::AssetManager::_LinkUnused(_Shard& shard, uint32_t index)
 {
-	_warps.emplace(path, _AssetInstanceWarp{ 0, {}, assetInstance });
+	auto& warp = shard.warps[index];
+	warp.unused = true;
+	warp.prevUnused = NULL_INDEX;
+	warp.nextUnused = shard.unusedHead;
+	if (shard.unusedHead != NULL_INDEX) shard.warps[shard.unusedHead].prevUnused = index;
+	shard.unusedHead = index;
 }
 
-IO::Asset::IAssetInstance* IO::Manager::AssetManager::_AcquireInstance(std::string path, IO::Asset::IAsset* newAsset)
+void IO::Manager::AssetManager::_UnlinkUnused(_Shard& shard, uint32_t index)
 {
-	_warps[path].refCount++;
-	_warps[path].assets.emplace(newAsset);
-	return _warps[path].assetInstance;
+	auto& warp = shard.warps[index];
+	if (warp.prevUnused != NULL_INDEX) shard.warps[warp.prevUnused].nextUnused = warp.nextUnused;
+	else shard.unusedHead = warp.nextUnused;
+	if (warp.nextUnused != NULL_INDEX) shard.warps[warp.nextUnused].prevUnused = warp.prevUnused;
+	warp.unused = false;
+	warp.prevUnused = NULL_INDEX;
+	warp.nextUnused = NULL_INDEX;
 }
 
-bool IO::Manager::AssetManager::_ContainsInstance(std::string path)
+void IO::Manager::AssetManager::_Evict(_Shard& shard, uint32_t index)
 {
-	return _warps.count(path);
+	auto& warp = shard.warps[index];
+	_UnlinkUnused(shard, index);
+	shard.pathIndexs.erase(warp.assetInstance->path);
+	for (const auto& asset : warp.assets)
+	{
+		delete asset;
+	}
+	delete warp.assetInstance;
+	warp = _AssetInstanceWarp{ 0, {}, nullptr, typeid(void), false, 0, NULL_INDEX, NULL_INDEX };
+	shard.freeIndexs.emplace_back(index);
+}
+
+IO::Asset::IAssetInstance* IO::Manager::AssetManager::_AcquireInstance(const std::string& path, std::type_index assetType, IO::Asset::IAsset* newAsset, std::function<IO::Asset::IAssetInstance*()> createInstance, bool& created)
+{
+	uint32_t shardIndex = _ShardIndex(path);
+	auto& shard = _shards[shardIndex];
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	uint32_t index = NULL_INDEX;
+	auto iterator = shard.pathIndexs.find(path);
+	if (iterator != shard.pathIndexs.end())
+	{
+		index = iterator->second;
+		shard.counters[assetType].hitCount++;
+		created = false;
+	}
+	else
+	{
+		if (shard.freeIndexs.empty())
+		{
+			index = static_cast<uint32_t>(shard.warps.size());
+			shard.warps.push_back(_AssetInstanceWarp{ 0, {}, nullptr, typeid(void), false, 0, NULL_INDEX, NULL_INDEX });
+		}
+		else
+		{
+			index = shard.freeIndexs.back();
+			shard.freeIndexs.pop_back();
+		}
+		IO::Asset::IAssetInstance* assetInstance = createInstance();
+		assetInstance->_pathId = index * SHARD_COUNT + shardIndex;
+		shard.warps[index] = _AssetInstanceWarp{ 0, {}, assetInstance, assetType, false, 0, NULL_INDEX, NULL_INDEX };
+		shard.pathIndexs.emplace(path, index);
+		shard.counters[assetType].missCount++;
+		created = true;
+	}
+
+	auto& warp = shard.warps[index];
+	if (warp.unused) _UnlinkUnused(shard, index);
+	warp.refCount++;
+	warp.assets.emplace(newAsset);
+	return warp.assetInstance;
 }
 
 void IO::Manager::AssetManager::_ReleaseInstance(IO::Asset::IAssetInstance* assetInstance, IO::Asset::IAsset* newAsset)
 {
-	if (_warps[assetInstance->path].assets.count(newAsset))
+	auto& shard = _shards[assetInstance->_pathId % SHARD_COUNT];
+	std::unique_lock<std::mutex> lock(shard.mutex);
+
+	uint32_t index = assetInstance->_pathId / SHARD_COUNT;
+	auto& warp = shard.warps[index];
+	if (warp.assets.count(newAsset))
 	{
-		--_warps[assetInstance->path].refCount;
-		_warps[assetInstance->path].assets.erase(newAsset);
+		--warp.refCount;
+		warp.assets.erase(newAsset);
+		if (warp.refCount == 0)
+		{
+			warp.unusedTick = ++_unusedTick;
+			_LinkUnused(shard, index);
+		}
 	}
 }
@@ -18,30 +18,26 @@ RTTR_REGISTRATION
 	registration::class_<Logic::Component::Camera::Camera>("Logic::Component::Camera::Camera");
 }
 
-void Logic::Component::Camera::Camera::SetCameraData()
+Logic::Component::Camera::Camera::CameraData Logic::Component::Camera::Camera::GetCameraData()
 {
+	CameraData cameraData{};
 	std::array<glm::vec4, 6> clipPlanes = ClipPlanes();
-	_cameraData.type = static_cast<int>(cameraType);
-	_cameraData.nearFlat = nearFlat;
-	_cameraData.farFlat = farFlat;
-	_cameraData.aspectRatio = aspectRatio;
-	_cameraData.position = _modelMatrix * glm::vec4(0, 0, 0, 1);
-	_cameraData.parameter = GetParameter();
-	_cameraData.forward = glm::normalize(glm::vec3(_modelMatrix * glm::vec4(0, 0, -1, 0)));
-	_cameraData.right = glm::normalize(glm::vec3(_modelMatrix * glm::vec4(1, 0, 0, 0)));
-	memcpy(&_cameraData.clipPlanes, clipPlanes.data(), sizeof(glm::vec4) * 6);
+	cameraData.type = static_cast<int>(cameraType);
+	cameraData.nearFlat = nearFlat;
+	cameraData.farFlat = farFlat;
+	cameraData.aspectRatio = aspectRatio;
+	cameraData.position = _modelMatrix * glm::vec4(0, 0, 0, 1);
+	cameraData.parameter = GetParameter();
+	cameraData.forward = glm::normalize(glm::vec3(_modelMatrix * glm::vec4(0, 0, -1, 0)));
+	cameraData.right = glm::normalize(glm::vec3(_modelMatrix * glm::vec4(1, 0, 0, 0)));
+	memcpy(&cameraData.clipPlanes, clipPlanes.data(), sizeof(glm::vec4) * 6);
+	return cameraData;
 }
 
-void Logic::Component::Camera::Camera::CopyCameraData(Graphic::Command::CommandBuffer* commandBuffer)
+void Logic::Component::Camera::Camera::CopyCameraData(Graphic::Command::CommandBuffer* commandBuffer, CameraData& cameraData)
 {
-	_stageBuffer->WriteBuffer(&_cameraData, sizeof(CameraData));
-
-	commandBuffer->Reset();
-	commandBuffer->BeginRecord(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+	_stageBuffer->WriteBuffer(&cameraData, sizeof(CameraData));
 	commandBuffer->CopyBuffer(_stageBuffer, _buffer);
-	commandBuffer->EndRecord();
-	commandBuffer->Submit({}, {}, {});
-	commandBuffer->WaitForFinish();
 }
 
 Graphic::Instance::Buffer* Logic::Component::Camera::Camera::CameraDataBuffer()
@@ -65,7 +61,6 @@ Logic::Component::Camera::Camera::Camera(CameraType cameraType)
 	, nearFlat(3.0f)
 	, farFlat(100.0f)
 	, aspectRatio(16.0f / 9.0f)
-	, _cameraData()
 	, _modelMatrix(glm::mat4(1.0f))
 	, _stageBuffer(new Graphic::Instance::Buffer(sizeof(CameraData), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
 	, _buffer(new Graphic::Instance::Buffer(sizeof(CameraData), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT))
@@ -85,6 +80,18 @@ glm::mat4 Logic::Component::Camera::Camera::ViewMatrix()
 	return glm::lookAt(eye, center, up);
 }
 
+std::array<glm::vec4, 6> Logic::Component::Camera::Camera::WorldClipPlanes()
+{
+	//Clip planes are in view space, dot(view * v, p) == dot(v, transpose(view) * p)
+	std::array<glm::vec4, 6> clipPlanes = ClipPlanes();
+	glm::mat4 planeMatrix = glm::transpose(ViewMatrix());
+	for (auto& clipPlane : clipPlanes)
+	{
+		clipPlane = planeMatrix * clipPlane;
+	}
+	return clipPlanes;
+}
+
 const glm::mat4& Logic::Component::Camera::Camera::ModelMatrix()
 {
 	return _modelMatrix;
@@ -2,6 +2,9 @@
 #include "Graphic/Instance/Buffer.h"
 #include "Logic/Object/GameObject.h"
 #include "Graphic/Material.h"
+#include "Graphic/Asset/Mesh.h"
+#include <glm/glm.hpp>
+#include <limits>
 #include <Utils/Log.h>
 #include <rttr/registration>
 RTTR_REGISTRATION
@@ -12,31 +15,95 @@ RTTR_REGISTRATION
 
 void Logic::Component::Renderer::Renderer::OnUpdate()
 {
-	_modelMatrix = _gameObject->transform.ModelMatrix();
+	_UpdateRendererTree(_UpdateBounds());
+}
+
+bool Logic::Component::Renderer::Renderer::_UpdateBounds()
+{
+	//Static renderers keep their matrix and bounds until the transform or mesh changes
+	auto& transform = _gameObject->transform;
+	if (transform.ModelMatrixVersion() == _boundsVersion && mesh == _boundsMesh) return false;
+	_modelMatrix = transform.ModelMatrix();
+	_boundsVersion = transform.ModelMatrixVersion();
+	_boundsMesh = mesh;
+	if (!mesh) return true;
+
+	_boundsMin = glm::vec3(std::numeric_limits<float>::max());
+	_boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+	for (const auto& boundryVertex : mesh->OrientedBoundingBox().BoundryVertexes())
+	{
+		glm::vec3 worldVertex = _modelMatrix * glm::vec4(boundryVertex, 1.0f);
+		_boundsMin = glm::min(_boundsMin, worldVertex);
+		_boundsMax = glm::max(_boundsMax, worldVertex);
+	}
+	return true;
+}
+
+void Logic::Component::Renderer::Renderer::_UpdateRendererTree(bool boundsChanged)
+{
+	auto& rendererTree = Core::Instance::rendererTree;
+
+	//Renderers that are never culled stay out of the tree and are always drawn
+	if (!enableFrustumCulling || !mesh)
+	{
+		if (_rendererTreeProxy != Utils::DynamicBvh::NULL_PROXY)
+		{
+			rendererTree._bvh.Remove(_rendererTreeProxy);
+			_rendererTreeProxy = Utils::DynamicBvh::NULL_PROXY;
+			rendererTree._untrackedRenderers.insert(this);
+		}
+		return;
+	}
+
+	if (_rendererTreeProxy == Utils::DynamicBvh::NULL_PROXY)
+	{
+		_rendererTreeProxy = rendererTree._bvh.Insert(_boundsMin, _boundsMax, this);
+		rendererTree._untrackedRenderers.erase(this);
+	}
+	else if (boundsChanged)
+	{
+		rendererTree._bvh.Update(_rendererTreeProxy, _boundsMin, _boundsMax);
+	}
+}
+
+void Logic::Component::Renderer::Renderer::_OnTransformChanged()
+{
+	if (_UpdateBounds()) _UpdateRendererTree(true);
 }
 
 Logic::Component::Renderer::Renderer::Renderer()
 	: Component(ComponentType::RENDERER)
 	, _modelMatrix()
-	, _matrixBuffer(new Graphic::Instance::Buffer(sizeof(MatrixData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
 	, mesh(nullptr)
 	, material(nullptr)
 	, enableFrustumCulling(true)
+	, _rendererTreeProxy(Utils::DynamicBvh::NULL_PROXY)
+	, _boundsVersion(0)
+	, _boundsMesh(nullptr)
+	, _boundsMin(0)
+	, _boundsMax(0)
 {
+	//Drawn untested until its first update finds a mesh
+	Core::Instance::rendererTree._untrackedRenderers.insert(this);
 }
 
 Logic::Component::Renderer::Renderer::~Renderer()
 {
+	if (_rendererTreeProxy != Utils::DynamicBvh::NULL_PROXY) Core::Instance::rendererTree._bvh.Remove(_rendererTreeProxy);
+	Core::Instance::rendererTree._untrackedRenderers.erase(this);
 }
 
-void Logic::Component::Renderer::Renderer::SetMatrixData(glm::mat4& viewMatrix, glm::mat4& projectionMatrix)
+const glm::mat4& Logic::Component::Renderer::Renderer::ModelMatrix()
 {
-	MatrixData data = { _modelMatrix , viewMatrix , projectionMatrix, glm::transpose(glm::inverse(_modelMatrix))};
-	_matrixBuffer->WriteBuffer(&data, sizeof(MatrixData));
-	material->SetUniformBuffer("matrixData", _matrixBuffer);
+	return _modelMatrix;
 }
 
-const glm::mat4& Logic::Component::Renderer::Renderer::ModelMatrix()
+const glm::vec3& Logic::Component::Renderer::Renderer::BoundsMin()
 {
-	return _modelMatrix;
+	return _boundsMin;
+}
+
+const glm::vec3& Logic::Component::Renderer::Renderer::BoundsMax()
+{
+	return _boundsMax;
 }
@@ -1,5 +1,6 @@
 #include "Logic/Component/Transform/Transform.h"
 #include "Logic/Object/GameObject.h"
+#include "Logic/Component/Renderer/Renderer.h"
 #include <rttr/registration>
 #include <glm/glm.hpp>
 RTTR_REGISTRATION
@@ -23,6 +24,8 @@ RTTR_REGISTRATION
         ;
 }
 
+uint64_t Logic::Component::Transform::Transform::_modelMatrixVersionCounter = 0;
+
 Logic::Component::Transform::Transform::Transform()
     : Component(Component::ComponentType::TRANSFORM)
     , _translation(glm::vec3(0, 0, 0))
@@ -30,6 +33,7 @@ Logic::Component::Transform::Transform::Transform()
     , _scale(glm::vec3(1, 1, 1))
     , _relativeModelMatrix(glm::mat4(1))
     , _modelMatrix(glm::mat4(1))
+    , _modelMatrixVersion(++_modelMatrixVersionCounter)
 {
     
 }
@@ -50,6 +54,15 @@ void Logic::Component::Transform::Transform::SetActive()
 void Logic::Component::Transform::Transform::UpdateModelMatrix(glm::mat4& parentModelMatrix)
 {
     _modelMatrix = parentModelMatrix * _relativeModelMatrix;
+    _modelMatrixVersion = ++_modelMatrixVersionCounter;
+    auto rendererHead = _gameObject->_typeSqueueComponentsHeadMap.find(ComponentType::RENDERER);
+    if (rendererHead != _gameObject->_typeSqueueComponentsHeadMap.end())
+    {
+        for (auto iterator = rendererHead->second->GetIterator(); iterator.IsValid(); iterator++)
+        {
+            static_cast<Renderer::Renderer*>(static_cast<Component*>(iterator.Node()))->_OnTransformChanged();
+        }
+    }
     auto child = _gameObject->Child();
     while (child)
     {
@@ -132,6 +145,11 @@ glm::mat4 Logic::Component::Transform::Transform::ModelMatrix()
     return _modelMatrix;
 }
 
+uint64_t Logic::Component::Transform::Transform::ModelMatrixVersion()
+{
+    return _modelMatrixVersion;
+}
+
 glm::vec3 Logic::Component::Transform::Transform::Rotation()
 {
     return _rotation;
@@ -1,11 +1,15 @@
 #include "Logic/Core/Instance.h"
 #include "Logic/Object/GameObject.h"
+#include "Logic/Component/Camera/Camera.h"
+#include "Logic/Component/Renderer/Renderer.h"
+#include <limits>
 
 Logic::Core::Instance::RootGameObject Logic::Core::Instance::rootObject = Logic::Core::Instance::RootGameObject();
 Utils::Condition* Logic::Core::Instance::_exitCondition = new Utils::Condition();
 std::unordered_set<Logic::Object::GameObject*> Logic::Core::Instance::_validGameObjectInIteration = std::unordered_set<Logic::Object::GameObject*>();
 std::unordered_set<Logic::Component::Component*> Logic::Core::Instance::_validComponentInIteration = std::unordered_set<Logic::Component::Component*>();
 Logic::Core::Instance::Time Logic::Core::Instance::time = Logic::Core::Instance::Time();
+Logic::Core::Instance::RendererTree Logic::Core::Instance::rendererTree = Logic::Core::Instance::RendererTree();
 
 void Logic::Core::Instance::Exit()
 {
@@ -41,4 +45,79 @@ Logic::Core::Instance::Time::Time()
 
 Logic::Core::Instance::Time::~Time()
 {
+}
+
+Logic::Core::Instance::RendererTree::RendererTree()
+	: _bvh(0.1f)
+	, _untrackedRenderers()
+	, _results()
+{
+}
+
+Logic::Core::Instance::RendererTree::~RendererTree()
+{
+}
+
+void Logic::Core::Instance::RendererTree::Cull(Component::Camera::Camera* camera, std::vector<Component::Component*>& visibleRenderers)
+{
+	visibleRenderers.clear();
+	for (const auto& renderer : _untrackedRenderers)
+	{
+		if (_InScene(renderer)) visibleRenderers.emplace_back(renderer);
+	}
+
+	_results.clear();
+	if (camera)
+	{
+		auto clipPlanes = camera->WorldClipPlanes();
+		_bvh.Query(clipPlanes.data(), clipPlanes.size(), _results);
+	}
+	else
+	{
+		_bvh.Query(glm::vec3(std::numeric_limits<float>::lowest()), glm::vec3(std::numeric_limits<float>::max()), _results);
+	}
+	for (const auto& result : _results)
+	{
+		auto renderer = static_cast<Component::Renderer::Renderer*>(result);
+		if (_InScene(renderer)) visibleRenderers.emplace_back(renderer);
+	}
+}
+
+bool Logic::Core::Instance::RendererTree::_InScene(Component::Renderer::Renderer* renderer)
+{
+	//Renderers removed from their game object or hanging under a removed game object stay registered until they are destroyed
+	auto gameObject = renderer->GameObject();
+	if (!gameObject) return false;
+	while (gameObject->HaveParent())
+	{
+		gameObject = gameObject->Parent();
+	}
+	return gameObject == &Instance::rootObject._gameObject;
+}
+
+void Logic::Core::Instance::RendererTree::RayCast(glm::vec3 origin, glm::vec3 direction, float maxDistance, std::vector<Component::Renderer::Renderer*>& renderers)
+{
+	_results.clear();
+	_bvh.RayCast(origin, direction, maxDistance, _results);
+	for (const auto& result : _results)
+	{
+		auto renderer = static_cast<Component::Renderer::Renderer*>(result);
+		if (renderer->GameObject()) renderers.emplace_back(renderer);
+	}
+}
+
+void Logic::Core::Instance::RendererTree::Query(glm::vec3 boundsMin, glm::vec3 boundsMax, std::vector<Component::Renderer::Renderer*>& renderers)
+{
+	_results.clear();
+	_bvh.Query(boundsMin, boundsMax, _results);
+	for (const auto& result : _results)
+	{
+		auto renderer = static_cast<Component::Renderer::Renderer*>(result);
+		if (renderer->GameObject()) renderers.emplace_back(renderer);
+	}
+}
+
+uint32_t Logic::Core::Instance::RendererTree::Count()
+{
+	return _bvh.ProxyCount();
 }
\ No newline at end of file
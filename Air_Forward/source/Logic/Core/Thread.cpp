@@ -394,6 +394,12 @@ void Logic::Core::Thread::LogicThread::OnRun()
 	meshRendererCulledGo->AddComponent(new Test::MeshRendererBehaviour());
 	meshRendererCulledGo->transform.SetTranslation(glm::vec3(2000, 2000, 2000));
 
+	Logic::Object::GameObject* meshRendererOccludedGo = new Logic::Object::GameObject("MeshRendererOccluded");
+	renderers->AddChild(meshRendererOccludedGo);
+	meshRendererOccludedGo->AddComponent(new Component::Renderer::MeshRenderer());
+	meshRendererOccludedGo->AddComponent(new Test::MeshRendererBehaviour());
+	meshRendererOccludedGo->transform.SetScale(glm::vec3(0.2, 0.2, 0.2));
+
 	//Lights
 	Logic::Object::GameObject* transparentRenderers = new Logic::Object::GameObject("TransparentRenderers");
 	renderers->AddChild(transparentRenderers);
@@ -552,6 +558,7 @@ void Logic::Core::Thread::LogicThread::OnRun()
 	//	pointLightGo->AddComponent(pointLight);
 	//}
 
+	std::vector<Logic::Component::Component*> visibleRenderers = std::vector<Logic::Component::Component*>();
 	while (!_stopped)
 	{	
 		Utils::Log::Message("----------------------------------------------------");
@@ -562,17 +569,25 @@ void Logic::Core::Thread::LogicThread::OnRun()
 		auto cameras = std::vector<Logic::Component::Component*>();
 
 		auto targetComponents = std::vector<std::vector<Logic::Component::Component*>>();
-		IterateByStaticBfs({ Component::Component::ComponentType::LIGHT, Component::Component::ComponentType::CAMERA, Component::Component::ComponentType::RENDERER }, targetComponents);
+		IterateByStaticBfs({ Component::Component::ComponentType::LIGHT, Component::Component::ComponentType::CAMERA }, targetComponents);
+
+		//Renderers come from the tree instead of the hierarchy, only the ones the first camera sees are updated and snapshotted
+		Instance::rendererTree.Cull(targetComponents[1].empty() ? nullptr : static_cast<Component::Camera::Camera*>(targetComponents[1][0]), visibleRenderers);
+		for (const auto& renderer : visibleRenderers)
+		{
+			renderer->Update();
+		}
+
+		//Wait for a free frame snapshot, render thread keeps working on the previous ones
+		Graphic::Core::Instance::AcquireLogicFrame();
+		Utils::Log::Message("Core::Thread::LogicThread acquire frame snapshot.");
 
 		Graphic::Core::Instance::AddLight(targetComponents[0]);
 		Graphic::Core::Instance::AddCamera(targetComponents[1]);
-		Graphic::Core::Instance::AddRenderer(targetComponents[2]);
+		Graphic::Core::Instance::AddRenderer(visibleRenderers);
 
-		Utils::Log::Message("Core::Thread::LogicThread awake render start.");
-		Graphic::Core::Instance::RenderStartCondition().Awake();
-		//RenderThread render
-		Graphic::Core::Instance::RenderEndCondition().Wait();
-		Utils::Log::Message("Core::Thread::LogicThread finish wait render finish.");
+		Graphic::Core::Instance::SubmitLogicFrame();
+		Utils::Log::Message("Core::Thread::LogicThread submit frame snapshot.");
 		
 		Utils::Log::Message("----------------------------------------------------\n");
 	}
@@ -0,0 +1,93 @@
+#include "Test/CullBenchmark.h"
+#include "Utils/IntersectionChecker.h"
+#include "Utils/Log.h"
+#include <array>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+void Test::CullBenchmark::Run()
+{
+	for (size_t boundsCount : { static_cast<size_t>(10000), static_cast<size_t>(100000), static_cast<size_t>(1000000) })
+	{
+		_Run(boundsCount);
+	}
+}
+
+void Test::CullBenchmark::_Run(size_t boundsCount)
+{
+	//View space frustum of a 90 degree camera from 0.1 to 100, moved off the origin
+	glm::mat4 viewMatrix = glm::mat4(1.0f);
+	viewMatrix[3] = glm::vec4(1.5f, -2.0f, -3.0f, 1.0f);
+	std::array<glm::vec4, 6> planes = {
+		glm::vec4(1, 0, -1, 0),
+		glm::vec4(-1, 0, -1, 0),
+		glm::vec4(0, 1, -1, 0),
+		glm::vec4(0, -1, -1, 0),
+		glm::vec4(0, 0, -1, -0.1f),
+		glm::vec4(0, 0, 1, 100)
+	};
+	Utils::IntersectionChecker intersectionChecker = Utils::IntersectionChecker();
+	intersectionChecker.SetIntersectPlanes(planes.data(), planes.size());
+
+	std::mt19937 random(1);
+	std::uniform_real_distribution<float> positionDistribution(-120.0f, 120.0f);
+	std::uniform_real_distribution<float> extentDistribution(0.1f, 3.0f);
+	std::vector<glm::vec3> boundsMins = std::vector<glm::vec3>(boundsCount);
+	std::vector<glm::vec3> boundsMaxs = std::vector<glm::vec3>(boundsCount);
+	Utils::IntersectionChecker::BoundsArray boundsArray = Utils::IntersectionChecker::BoundsArray();
+	for (size_t i = 0; i < boundsCount; i++)
+	{
+		glm::vec3 center = glm::vec3(positionDistribution(random), positionDistribution(random), positionDistribution(random));
+		glm::vec3 extent = glm::vec3(extentDistribution(random), extentDistribution(random), extentDistribution(random));
+		boundsMins[i] = center - extent;
+		boundsMaxs[i] = center + extent;
+		boundsArray.Add(boundsMins[i], boundsMaxs[i]);
+	}
+
+	//Per object path, the 8 corners of every box
+	std::vector<bool> objectVisibles = std::vector<bool>(boundsCount);
+	auto objectStartTime = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < boundsCount; i++)
+	{
+		const glm::vec3& boundsMin = boundsMins[i];
+		const glm::vec3& boundsMax = boundsMaxs[i];
+		std::array<glm::vec3, 8> vertexes = {
+			glm::vec3(boundsMin.x, boundsMin.y, boundsMin.z),
+			glm::vec3(boundsMin.x, boundsMin.y, boundsMax.z),
+			glm::vec3(boundsMin.x, boundsMax.y, boundsMin.z),
+			glm::vec3(boundsMin.x, boundsMax.y, boundsMax.z),
+			glm::vec3(boundsMax.x, boundsMin.y, boundsMin.z),
+			glm::vec3(boundsMax.x, boundsMin.y, boundsMax.z),
+			glm::vec3(boundsMax.x, boundsMax.y, boundsMin.z),
+			glm::vec3(boundsMax.x, boundsMax.y, boundsMax.z)
+		};
+		objectVisibles[i] = intersectionChecker.Check(vertexes.data(), vertexes.size(), viewMatrix);
+	}
+	double objectTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - objectStartTime).count();
+
+	//Batch path, averaged since one pass is short
+	const uint32_t batchRepeatCount = 10;
+	std::vector<uint64_t> visibleMasks = std::vector<uint64_t>();
+	auto batchStartTime = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < batchRepeatCount; i++)
+	{
+		intersectionChecker.Check(boundsArray, viewMatrix, visibleMasks);
+	}
+	double batchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - batchStartTime).count() / batchRepeatCount;
+
+	size_t visibleCount = 0;
+	size_t mismatchCount = 0;
+	for (size_t i = 0; i < boundsCount; i++)
+	{
+		bool visible = (visibleMasks[i / 64] >> (i % 64)) & 1;
+		visibleCount += visible;
+		mismatchCount += visible != objectVisibles[i];
+	}
+
+	Utils::Log::Message(
+		"Test::CullBenchmark " + std::to_string(boundsCount) + " bounds: per object " + std::to_string(objectTime) + " ms, batch "
+		+ std::to_string(batchTime) + " ms, " + std::to_string(visibleCount) + " visible, " + std::to_string(mismatchCount) + " mismatches."
+	);
+}
\ No newline at end of file
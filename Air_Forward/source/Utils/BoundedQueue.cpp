@@ -0,0 +1,75 @@
+#include "Utils/BoundedQueue.h"
+#include "Utils/Log.h"
+#include <cstdint>
+
+Utils::BoundedQueue::BoundedQueue(size_t capacity)
+	: _mask(capacity - 1)
+	, _cells(capacity)
+	, _enqueuePosition(0)
+	, _dequeuePosition(0)
+{
+	Utils::Log::Exception("Utils::BoundedQueue capacity must be a power of two.", capacity < 2 || (capacity & (capacity - 1)) != 0);
+
+	for (size_t i = 0; i < capacity; i++)
+	{
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+Utils::BoundedQueue::~BoundedQueue()
+{
+}
+
+bool Utils::BoundedQueue::Enqueue(uint32_t value)
+{
+	size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+	_Cell* cell;
+	while (true)
+	{
+		cell = &_cells[position & _mask];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+		if (difference == 0)
+		{
+			if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+		}
+		else if (difference < 0)
+		{
+			return false;
+		}
+		else
+		{
+			position = _enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+	cell->value = value;
+	cell->sequence.store(position + 1, std::memory_order_release);
+	return true;
+}
+
+bool Utils::BoundedQueue::Dequeue(uint32_t& value)
+{
+	size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+	_Cell* cell;
+	while (true)
+	{
+		cell = &_cells[position & _mask];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+		if (difference == 0)
+		{
+			if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+		}
+		else if (difference < 0)
+		{
+			return false;
+		}
+		else
+		{
+			position = _dequeuePosition.load(std::memory_order_relaxed);
+		}
+	}
+	value = cell->value;
+	cell->sequence.store(position + _mask + 1, std::memory_order_release);
+	return true;
+}
\ No newline at end of file
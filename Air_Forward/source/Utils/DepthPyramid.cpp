@@ -0,0 +1,140 @@
+#include "Utils/DepthPyramid.h"
+#include <algorithm>
+#include <limits>
+
+void Utils::DepthPyramid::Build(const float* depths, uint32_t width, uint32_t height, const glm::mat4& viewProjection)
+{
+	_valid = false;
+	if (width == 0 || height == 0) return;
+
+	//Halve down to a single texel, odd edges fold into the last texel
+	_levels.clear();
+	size_t depthCount = 0;
+	uint32_t levelWidth = width;
+	uint32_t levelHeight = height;
+	do
+	{
+		levelWidth = (levelWidth + 1) / 2;
+		levelHeight = (levelHeight + 1) / 2;
+		_levels.push_back({ levelWidth, levelHeight, depthCount });
+		depthCount += static_cast<size_t>(levelWidth) * levelHeight;
+	} while (levelWidth > 1 || levelHeight > 1);
+	_depths.resize(depthCount);
+
+	_Reduce(depths, width, height, _depths.data(), _levels[0].width, _levels[0].height);
+	for (size_t i = 1; i < _levels.size(); i++)
+	{
+		const auto& srcLevel = _levels[i - 1];
+		const auto& dstLevel = _levels[i];
+		_Reduce(_depths.data() + srcLevel.offset, srcLevel.width, srcLevel.height, _depths.data() + dstLevel.offset, dstLevel.width, dstLevel.height);
+	}
+
+	_viewProjection = viewProjection;
+	_width = width;
+	_height = height;
+	_valid = true;
+}
+
+void Utils::DepthPyramid::Invalidate()
+{
+	_valid = false;
+}
+
+bool Utils::DepthPyramid::Valid() const
+{
+	return _valid;
+}
+
+uint32_t Utils::DepthPyramid::LevelCount() const
+{
+	return static_cast<uint32_t>(_levels.size());
+}
+
+bool Utils::DepthPyramid::IsOccluded(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const
+{
+	if (!_valid) return false;
+
+	float minX = std::numeric_limits<float>::max();
+	float minY = std::numeric_limits<float>::max();
+	float maxX = std::numeric_limits<float>::lowest();
+	float maxY = std::numeric_limits<float>::lowest();
+	float minDepth = std::numeric_limits<float>::max();
+	for (uint32_t i = 0; i < 8; i++)
+	{
+		glm::vec4 corner = _viewProjection * glm::vec4(
+			(i & 1) ? boundsMax.x : boundsMin.x,
+			(i & 2) ? boundsMax.y : boundsMin.y,
+			(i & 4) ? boundsMax.z : boundsMin.z,
+			1.0f
+		);
+		if (corner.w <= 0.0f || corner.z < 0.0f) return false;
+		float inverseW = 1.0f / corner.w;
+		float x = corner.x * inverseW;
+		float y = corner.y * inverseW;
+		minX = std::min(minX, x);
+		minY = std::min(minY, y);
+		maxX = std::max(maxX, x);
+		maxY = std::max(maxY, y);
+		minDepth = std::min(minDepth, corner.z * inverseW);
+	}
+	//Off screen boxes are left to the frustum
+	if (maxX < -1.0f || minX > 1.0f || maxY < -1.0f || minY > 1.0f) return false;
+
+	//Covered pixels of the source, framebuffer rows grow with ndc y
+	uint32_t x0 = static_cast<uint32_t>(std::clamp((minX * 0.5f + 0.5f) * _width, 0.0f, static_cast<float>(_width - 1)));
+	uint32_t x1 = static_cast<uint32_t>(std::clamp((maxX * 0.5f + 0.5f) * _width, 0.0f, static_cast<float>(_width - 1)));
+	uint32_t y0 = static_cast<uint32_t>(std::clamp((minY * 0.5f + 0.5f) * _height, 0.0f, static_cast<float>(_height - 1)));
+	uint32_t y1 = static_cast<uint32_t>(std::clamp((maxY * 0.5f + 0.5f) * _height, 0.0f, static_cast<float>(_height - 1)));
+
+	//Coarsest level needed to cover the rectangle with at most 2x2 texels
+	uint32_t levelIndex = 0;
+	while (levelIndex + 1 < _levels.size() && ((x1 >> (levelIndex + 1)) - (x0 >> (levelIndex + 1)) > 1 || (y1 >> (levelIndex + 1)) - (y0 >> (levelIndex + 1)) > 1))
+	{
+		levelIndex++;
+	}
+	const auto& level = _levels[levelIndex];
+	const float* levelDepths = _depths.data() + level.offset;
+	float maxDepth = 0.0f;
+	for (uint32_t y = y0 >> (levelIndex + 1); y <= (y1 >> (levelIndex + 1)); y++)
+	{
+		for (uint32_t x = x0 >> (levelIndex + 1); x <= (x1 >> (levelIndex + 1)); x++)
+		{
+			maxDepth = std::max(maxDepth, levelDepths[static_cast<size_t>(y) * level.width + x]);
+		}
+	}
+	return minDepth > maxDepth;
+}
+
+void Utils::DepthPyramid::_Reduce(const float* srcDepths, uint32_t srcWidth, uint32_t srcHeight, float* dstDepths, uint32_t dstWidth, uint32_t dstHeight)
+{
+	for (uint32_t y = 0; y < dstHeight; y++)
+	{
+		const float* row0 = srcDepths + static_cast<size_t>(y * 2) * srcWidth;
+		const float* row1 = srcDepths + static_cast<size_t>(std::min(y * 2 + 1, srcHeight - 1)) * srcWidth;
+		float* dstRow = dstDepths + static_cast<size_t>(y) * dstWidth;
+		//Even pairs first so the loop stays branch free, an odd last column folds alone
+		uint32_t pairCount = srcWidth / 2;
+		for (uint32_t x = 0; x < pairCount; x++)
+		{
+			dstRow[x] = std::max(std::max(row0[x * 2], row0[x * 2 + 1]), std::max(row1[x * 2], row1[x * 2 + 1]));
+		}
+		if (pairCount < dstWidth)
+		{
+			dstRow[pairCount] = std::max(row0[srcWidth - 1], row1[srcWidth - 1]);
+		}
+	}
+}
+
+Utils::DepthPyramid::DepthPyramid()
+	: _levels()
+	, _depths()
+	, _viewProjection(1.0f)
+	, _width(0)
+	, _height(0)
+	, _valid(false)
+{
+}
+
+Utils::DepthPyramid::~DepthPyramid()
+{
+}
\ No newline at end of file
@@ -0,0 +1,414 @@
+#include "Utils/DynamicBvh.h"
+#include "Utils/Log.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+
+Utils::DynamicBvh::DynamicBvh(float margin)
+	: _nodes()
+	, _root(NULL_NODE)
+	, _freeNode(NULL_NODE)
+	, _proxyCount(0)
+	, _margin(margin)
+	, _stack()
+	, _rayHits()
+{
+}
+
+Utils::DynamicBvh::~DynamicBvh()
+{
+}
+
+uint32_t Utils::DynamicBvh::Insert(const glm::vec3& boundsMin, const glm::vec3& boundsMax, void* userData)
+{
+	uint32_t proxy = _AllocateNode();
+	_nodes[proxy].boundsMin = boundsMin - glm::vec3(_margin);
+	_nodes[proxy].boundsMax = boundsMax + glm::vec3(_margin);
+	_nodes[proxy].userData = userData;
+	_nodes[proxy].height = 0;
+	_InsertLeaf(proxy);
+	_proxyCount++;
+	return proxy;
+}
+
+bool Utils::DynamicBvh::Update(uint32_t proxy, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+	Utils::Log::Exception("Utils::DynamicBvh update a proxy that is not a leaf.", proxy >= _nodes.size() || _nodes[proxy].height != 0);
+
+	//Keep the leaf while it still contains the bounds and has not grown far beyond them
+	const auto& node = _nodes[proxy];
+	glm::vec3 largeMin = boundsMin - glm::vec3(_margin * 4);
+	glm::vec3 largeMax = boundsMax + glm::vec3(_margin * 4);
+	bool contained = glm::all(glm::lessThanEqual(node.boundsMin, boundsMin)) && glm::all(glm::lessThanEqual(boundsMax, node.boundsMax));
+	bool tight = glm::all(glm::lessThanEqual(largeMin, node.boundsMin)) && glm::all(glm::lessThanEqual(node.boundsMax, largeMax));
+	if (contained && tight) return false;
+
+	_RemoveLeaf(proxy);
+	_nodes[proxy].boundsMin = boundsMin - glm::vec3(_margin);
+	_nodes[proxy].boundsMax = boundsMax + glm::vec3(_margin);
+	_InsertLeaf(proxy);
+	return true;
+}
+
+void Utils::DynamicBvh::Remove(uint32_t proxy)
+{
+	Utils::Log::Exception("Utils::DynamicBvh remove a proxy that is not a leaf.", proxy >= _nodes.size() || _nodes[proxy].height != 0);
+	_RemoveLeaf(proxy);
+	_FreeNode(proxy);
+	_proxyCount--;
+}
+
+void* Utils::DynamicBvh::UserData(uint32_t proxy)
+{
+	return _nodes[proxy].userData;
+}
+
+void Utils::DynamicBvh::Query(const glm::vec4* planes, size_t planeCount, std::vector<void*>& results)
+{
+	Utils::Log::Exception("Utils::DynamicBvh query with more than 32 planes.", planeCount > 32);
+	if (_root == NULL_NODE) return;
+
+	//Each entry carries the planes its parent still straddles, planes a parent is fully inside of are never tested again below it
+	_stack.clear();
+	_stack.emplace_back(_root, planeCount == 32 ? UINT32_MAX : (1u << planeCount) - 1);
+	while (!_stack.empty())
+	{
+		uint32_t nodeIndex = _stack.back().first;
+		uint32_t planeMask = _stack.back().second;
+		_stack.pop_back();
+
+		const auto& node = _nodes[nodeIndex];
+		glm::vec3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+		glm::vec3 extent = (node.boundsMax - node.boundsMin) * 0.5f;
+		bool outside = false;
+		for (uint32_t j = 0; j < planeCount && !outside; j++)
+		{
+			if (!(planeMask & (1u << j))) continue;
+			float distance = glm::dot(center, glm::vec3(planes[j])) + planes[j].w;
+			float radius = glm::dot(extent, glm::abs(glm::vec3(planes[j])));
+			if (distance + radius < 0) outside = true;
+			else if (distance - radius >= 0) planeMask &= ~(1u << j);
+		}
+		if (outside) continue;
+
+		if (planeMask == 0)
+		{
+			_AddLeaves(nodeIndex, results);
+		}
+		else if (node.height == 0)
+		{
+			results.emplace_back(node.userData);
+		}
+		else
+		{
+			_stack.emplace_back(node.left, planeMask);
+			_stack.emplace_back(node.right, planeMask);
+		}
+	}
+}
+
+void Utils::DynamicBvh::Query(const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::vector<void*>& results)
+{
+	if (_root == NULL_NODE) return;
+
+	_stack.clear();
+	_stack.emplace_back(_root, 0);
+	while (!_stack.empty())
+	{
+		uint32_t nodeIndex = _stack.back().first;
+		_stack.pop_back();
+
+		const auto& node = _nodes[nodeIndex];
+		if (glm::any(glm::lessThan(node.boundsMax, boundsMin)) || glm::any(glm::lessThan(boundsMax, node.boundsMin))) continue;
+
+		if (node.height == 0)
+		{
+			results.emplace_back(node.userData);
+		}
+		else
+		{
+			_stack.emplace_back(node.left, 0);
+			_stack.emplace_back(node.right, 0);
+		}
+	}
+}
+
+void Utils::DynamicBvh::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<void*>& results)
+{
+	if (_root == NULL_NODE) return;
+
+	//Slab test, an axis the ray runs parallel to only rejects when the origin is outside that slab
+	auto intersect = [&origin, &direction, maxDistance](const _Node& node, float& enterDistance) {
+		float tMin = 0;
+		float tMax = maxDistance;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (std::abs(direction[axis]) < 1e-12f)
+			{
+				if (origin[axis] < node.boundsMin[axis] || origin[axis] > node.boundsMax[axis]) return false;
+				continue;
+			}
+			float inverse = 1.0f / direction[axis];
+			float t0 = (node.boundsMin[axis] - origin[axis]) * inverse;
+			float t1 = (node.boundsMax[axis] - origin[axis]) * inverse;
+			if (t0 > t1) std::swap(t0, t1);
+			tMin = std::max(tMin, t0);
+			tMax = std::min(tMax, t1);
+			if (tMin > tMax) return false;
+		}
+		enterDistance = tMin;
+		return true;
+	};
+
+	_rayHits.clear();
+	_stack.clear();
+	_stack.emplace_back(_root, 0);
+	while (!_stack.empty())
+	{
+		uint32_t nodeIndex = _stack.back().first;
+		_stack.pop_back();
+
+		const auto& node = _nodes[nodeIndex];
+		float enterDistance = 0;
+		if (!intersect(node, enterDistance)) continue;
+
+		if (node.height == 0)
+		{
+			_rayHits.emplace_back(enterDistance, node.userData);
+		}
+		else
+		{
+			_stack.emplace_back(node.left, 0);
+			_stack.emplace_back(node.right, 0);
+		}
+	}
+
+	std::sort(_rayHits.begin(), _rayHits.end(), [](const std::pair<float, void*>& a, const std::pair<float, void*>& b) {
+		return a.first < b.first;
+	});
+	for (const auto& rayHit : _rayHits)
+	{
+		results.emplace_back(rayHit.second);
+	}
+}
+
+uint32_t Utils::DynamicBvh::ProxyCount()
+{
+	return _proxyCount;
+}
+
+uint32_t Utils::DynamicBvh::Height()
+{
+	return _root == NULL_NODE ? 0 : static_cast<uint32_t>(_nodes[_root].height);
+}
+
+float Utils::DynamicBvh::_Area(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+	glm::vec3 size = boundsMax - boundsMin;
+	return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+uint32_t Utils::DynamicBvh::_AllocateNode()
+{
+	uint32_t nodeIndex = _freeNode;
+	if (nodeIndex == NULL_NODE)
+	{
+		nodeIndex = static_cast<uint32_t>(_nodes.size());
+		_nodes.emplace_back();
+	}
+	else
+	{
+		_freeNode = _nodes[nodeIndex].parent;
+	}
+	_nodes[nodeIndex] = { glm::vec3(0), glm::vec3(0), nullptr, NULL_NODE, NULL_NODE, NULL_NODE, 0 };
+	return nodeIndex;
+}
+
+void Utils::DynamicBvh::_FreeNode(uint32_t nodeIndex)
+{
+	_nodes[nodeIndex].parent = _freeNode;
+	_nodes[nodeIndex].height = -1;
+	_freeNode = nodeIndex;
+}
+
+void Utils::DynamicBvh::_InsertLeaf(uint32_t leafIndex)
+{
+	if (_root == NULL_NODE)
+	{
+		_root = leafIndex;
+		_nodes[leafIndex].parent = NULL_NODE;
+		return;
+	}
+
+	//Descend towards the sibling that grows the total surface area the least
+	glm::vec3 leafMin = _nodes[leafIndex].boundsMin;
+	glm::vec3 leafMax = _nodes[leafIndex].boundsMax;
+	uint32_t siblingIndex = _root;
+	while (_nodes[siblingIndex].height > 0)
+	{
+		const auto& node = _nodes[siblingIndex];
+		float area = _Area(node.boundsMin, node.boundsMax);
+		float combinedArea = _Area(glm::min(node.boundsMin, leafMin), glm::max(node.boundsMax, leafMax));
+		//Pairing here creates a parent over both, descending pushes the enlargement onto every ancestor
+		float cost = 2.0f * combinedArea;
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [this, &leafMin, &leafMax, inheritanceCost](uint32_t childIndex) {
+			const auto& child = _nodes[childIndex];
+			float enlargedArea = _Area(glm::min(child.boundsMin, leafMin), glm::max(child.boundsMax, leafMax));
+			if (child.height == 0) return enlargedArea + inheritanceCost;
+			return enlargedArea - _Area(child.boundsMin, child.boundsMax) + inheritanceCost;
+		};
+		float leftCost = childCost(node.left);
+		float rightCost = childCost(node.right);
+
+		if (cost < leftCost && cost < rightCost) break;
+		siblingIndex = leftCost < rightCost ? node.left : node.right;
+	}
+
+	uint32_t oldParentIndex = _nodes[siblingIndex].parent;
+	uint32_t newParentIndex = _AllocateNode();
+	_nodes[newParentIndex].parent = oldParentIndex;
+	_nodes[newParentIndex].boundsMin = glm::min(leafMin, _nodes[siblingIndex].boundsMin);
+	_nodes[newParentIndex].boundsMax = glm::max(leafMax, _nodes[siblingIndex].boundsMax);
+	_nodes[newParentIndex].height = _nodes[siblingIndex].height + 1;
+	_nodes[newParentIndex].left = siblingIndex;
+	_nodes[newParentIndex].right = leafIndex;
+	_nodes[siblingIndex].parent = newParentIndex;
+	_nodes[leafIndex].parent = newParentIndex;
+	if (oldParentIndex == NULL_NODE)
+	{
+		_root = newParentIndex;
+	}
+	else if (_nodes[oldParentIndex].left == siblingIndex)
+	{
+		_nodes[oldParentIndex].left = newParentIndex;
+	}
+	else
+	{
+		_nodes[oldParentIndex].right = newParentIndex;
+	}
+
+	_Refit(_nodes[leafIndex].parent);
+}
+
+void Utils::DynamicBvh::_RemoveLeaf(uint32_t leafIndex)
+{
+	if (leafIndex == _root)
+	{
+		_root = NULL_NODE;
+		return;
+	}
+
+	//The parent goes away and the sibling takes its place
+	uint32_t parentIndex = _nodes[leafIndex].parent;
+	uint32_t grandParentIndex = _nodes[parentIndex].parent;
+	uint32_t siblingIndex = _nodes[parentIndex].left == leafIndex ? _nodes[parentIndex].right : _nodes[parentIndex].left;
+	_nodes[siblingIndex].parent = grandParentIndex;
+	_FreeNode(parentIndex);
+	_nodes[leafIndex].parent = NULL_NODE;
+
+	if (grandParentIndex == NULL_NODE)
+	{
+		_root = siblingIndex;
+		return;
+	}
+	if (_nodes[grandParentIndex].left == parentIndex)
+	{
+		_nodes[grandParentIndex].left = siblingIndex;
+	}
+	else
+	{
+		_nodes[grandParentIndex].right = siblingIndex;
+	}
+	_Refit(grandParentIndex);
+}
+
+void Utils::DynamicBvh::_Refit(uint32_t nodeIndex)
+{
+	while (nodeIndex != NULL_NODE)
+	{
+		nodeIndex = _Balance(nodeIndex);
+
+		auto& node = _nodes[nodeIndex];
+		const auto& left = _nodes[node.left];
+		const auto& right = _nodes[node.right];
+		node.height = 1 + std::max(left.height, right.height);
+		node.boundsMin = glm::min(left.boundsMin, right.boundsMin);
+		node.boundsMax = glm::max(left.boundsMax, right.boundsMax);
+
+		nodeIndex = node.parent;
+	}
+}
+
+uint32_t Utils::DynamicBvh::_Balance(uint32_t nodeIndex)
+{
+	if (_nodes[nodeIndex].height < 2) return nodeIndex;
+
+	//Rotate the taller child up when the subtree heights differ by more than one
+	uint32_t leftIndex = _nodes[nodeIndex].left;
+	uint32_t rightIndex = _nodes[nodeIndex].right;
+	int32_t balance = _nodes[rightIndex].height - _nodes[leftIndex].height;
+	if (balance >= -1 && balance <= 1) return nodeIndex;
+
+	uint32_t upIndex = balance > 1 ? rightIndex : leftIndex;
+	uint32_t stayIndex = balance > 1 ? leftIndex : rightIndex;
+	uint32_t upLeftIndex = _nodes[upIndex].left;
+	uint32_t upRightIndex = _nodes[upIndex].right;
+	//The taller grandchild stays under the raised node, the other one moves down to this node
+	uint32_t keepIndex = _nodes[upLeftIndex].height > _nodes[upRightIndex].height ? upLeftIndex : upRightIndex;
+	uint32_t moveIndex = keepIndex == upLeftIndex ? upRightIndex : upLeftIndex;
+
+	uint32_t parentIndex = _nodes[nodeIndex].parent;
+	_nodes[upIndex].parent = parentIndex;
+	if (parentIndex == NULL_NODE)
+	{
+		_root = upIndex;
+	}
+	else if (_nodes[parentIndex].left == nodeIndex)
+	{
+		_nodes[parentIndex].left = upIndex;
+	}
+	else
+	{
+		_nodes[parentIndex].right = upIndex;
+	}
+
+	_nodes[upIndex].left = nodeIndex;
+	_nodes[upIndex].right = keepIndex;
+	_nodes[nodeIndex].parent = upIndex;
+	_nodes[nodeIndex].left = stayIndex;
+	_nodes[nodeIndex].right = moveIndex;
+	_nodes[moveIndex].parent = nodeIndex;
+
+	auto& node = _nodes[nodeIndex];
+	node.height = 1 + std::max(_nodes[stayIndex].height, _nodes[moveIndex].height);
+	node.boundsMin = glm::min(_nodes[stayIndex].boundsMin, _nodes[moveIndex].boundsMin);
+	node.boundsMax = glm::max(_nodes[stayIndex].boundsMax, _nodes[moveIndex].boundsMax);
+	auto& up = _nodes[upIndex];
+	up.height = 1 + std::max(node.height, _nodes[keepIndex].height);
+	up.boundsMin = glm::min(node.boundsMin, _nodes[keepIndex].boundsMin);
+	up.boundsMax = glm::max(node.boundsMax, _nodes[keepIndex].boundsMax);
+	return upIndex;
+}
+
+void Utils::DynamicBvh::_AddLeaves(uint32_t nodeIndex, std::vector<void*>& results)
+{
+	//Runs inside a query, so it keeps to the part of the stack above the caller's entries
+	size_t stackBase = _stack.size();
+	_stack.emplace_back(nodeIndex, 0);
+	while (_stack.size() > stackBase)
+	{
+		const auto& node = _nodes[_stack.back().first];
+		_stack.pop_back();
+		if (node.height == 0)
+		{
+			results.emplace_back(node.userData);
+		}
+		else
+		{
+			_stack.emplace_back(node.left, 0);
+			_stack.emplace_back(node.right, 0);
+		}
+	}
+}
\ No newline at end of file
@@ -1,4 +1,39 @@
 #include "Utils/IntersectionChecker.h"
+#include <algorithm>
+#if defined(__AVX__)
+#include <immintrin.h>
+#define INTERSECTION_CHECKER_AVX
+#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INTERSECTION_CHECKER_SSE
+#endif
+
+void Utils::IntersectionChecker::BoundsArray::Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+	glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	glm::vec3 extent = (boundsMax - boundsMin) * 0.5f;
+	centerXs.emplace_back(center.x);
+	centerYs.emplace_back(center.y);
+	centerZs.emplace_back(center.z);
+	extentXs.emplace_back(extent.x);
+	extentYs.emplace_back(extent.y);
+	extentZs.emplace_back(extent.z);
+}
+
+void Utils::IntersectionChecker::BoundsArray::Clear()
+{
+	centerXs.clear();
+	centerYs.clear();
+	centerZs.clear();
+	extentXs.clear();
+	extentYs.clear();
+	extentZs.clear();
+}
+
+size_t Utils::IntersectionChecker::BoundsArray::Count() const
+{
+	return centerXs.size();
+}
 
 void Utils::IntersectionChecker::SetIntersectPlanes(glm::vec4* planes, size_t planeCount)
 {
@@ -59,6 +94,113 @@ bool Utils::IntersectionChecker::Check(glm::vec3* vertexes, size_t vertexCount,
 	return true;
 }
 
+void Utils::IntersectionChecker::Check(const BoundsArray& bounds, glm::mat4 matrix, std::vector<uint64_t>& visibleMasks)
+{
+	Check(bounds, 0, bounds.Count(), matrix, visibleMasks);
+}
+
+void Utils::IntersectionChecker::Check(const BoundsArray& bounds, size_t begin, size_t end, glm::mat4 matrix, std::vector<uint64_t>& visibleMasks)
+{
+	//Bring the planes into the bounds' space instead of transforming every corner, dot(M * v, p) == dot(v, transpose(M) * p)
+	glm::mat4 planeMatrix = glm::transpose(matrix);
+	std::vector<glm::vec4> planes = std::vector<glm::vec4>(_intersectPlanes.size());
+	for (size_t j = 0; j < planes.size(); j++)
+	{
+		planes[j] = planeMatrix * _intersectPlanes[j];
+	}
+	_Check(bounds, begin, end, planes, visibleMasks);
+}
+
+void Utils::IntersectionChecker::Check(const BoundsArray& bounds, size_t begin, size_t end, std::vector<uint64_t>& visibleMasks)
+{
+	_Check(bounds, begin, end, _intersectPlanes, visibleMasks);
+}
+
+void Utils::IntersectionChecker::_Check(const BoundsArray& bounds, size_t begin, size_t end, const std::vector<glm::vec4>& planes, std::vector<uint64_t>& visibleMasks)
+{
+	end = std::min(end, bounds.Count());
+	begin = std::min(begin, end);
+	size_t count = end - begin;
+	visibleMasks.assign((count + 63) / 64, 0);
+
+	size_t planeCount = planes.size();
+	std::vector<glm::vec3> absNormals = std::vector<glm::vec3>(planeCount);
+	for (size_t j = 0; j < planeCount; j++)
+	{
+		absNormals[j] = glm::abs(glm::vec3(planes[j]));
+	}
+
+	const float* centerXs = bounds.centerXs.data() + begin;
+	const float* centerYs = bounds.centerYs.data() + begin;
+	const float* centerZs = bounds.centerZs.data() + begin;
+	const float* extentXs = bounds.extentXs.data() + begin;
+	const float* extentYs = bounds.extentYs.data() + begin;
+	const float* extentZs = bounds.extentZs.data() + begin;
+	size_t i = 0;
+
+	//The corner furthest along a plane normal is the center pushed by the extent along |normal|
+#if defined(INTERSECTION_CHECKER_AVX)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 centerX = _mm256_loadu_ps(centerXs + i);
+		__m256 centerY = _mm256_loadu_ps(centerYs + i);
+		__m256 centerZ = _mm256_loadu_ps(centerZs + i);
+		__m256 extentX = _mm256_loadu_ps(extentXs + i);
+		__m256 extentY = _mm256_loadu_ps(extentYs + i);
+		__m256 extentZ = _mm256_loadu_ps(extentZs + i);
+		__m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (size_t j = 0; j < planeCount; j++)
+		{
+			__m256 distance = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(centerX, _mm256_set1_ps(planes[j].x)), _mm256_mul_ps(centerY, _mm256_set1_ps(planes[j].y))),
+				_mm256_add_ps(_mm256_mul_ps(centerZ, _mm256_set1_ps(planes[j].z)), _mm256_set1_ps(planes[j].w))
+			);
+			__m256 radius = _mm256_add_ps(
+				_mm256_add_ps(_mm256_mul_ps(extentX, _mm256_set1_ps(absNormals[j].x)), _mm256_mul_ps(extentY, _mm256_set1_ps(absNormals[j].y))),
+				_mm256_mul_ps(extentZ, _mm256_set1_ps(absNormals[j].z))
+			);
+			visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		visibleMasks[i / 64] |= static_cast<uint64_t>(_mm256_movemask_ps(visible)) << (i % 64);
+	}
+#elif defined(INTERSECTION_CHECKER_SSE)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 centerX = _mm_loadu_ps(centerXs + i);
+		__m128 centerY = _mm_loadu_ps(centerYs + i);
+		__m128 centerZ = _mm_loadu_ps(centerZs + i);
+		__m128 extentX = _mm_loadu_ps(extentXs + i);
+		__m128 extentY = _mm_loadu_ps(extentYs + i);
+		__m128 extentZ = _mm_loadu_ps(extentZs + i);
+		__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (size_t j = 0; j < planeCount; j++)
+		{
+			__m128 distance = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(centerX, _mm_set1_ps(planes[j].x)), _mm_mul_ps(centerY, _mm_set1_ps(planes[j].y))),
+				_mm_add_ps(_mm_mul_ps(centerZ, _mm_set1_ps(planes[j].z)), _mm_set1_ps(planes[j].w))
+			);
+			__m128 radius = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(extentX, _mm_set1_ps(absNormals[j].x)), _mm_mul_ps(extentY, _mm_set1_ps(absNormals[j].y))),
+				_mm_mul_ps(extentZ, _mm_set1_ps(absNormals[j].z))
+			);
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+		visibleMasks[i / 64] |= static_cast<uint64_t>(_mm_movemask_ps(visible)) << (i % 64);
+	}
+#endif
+	for (; i < count; i++)
+	{
+		bool visible = true;
+		for (size_t j = 0; j < planeCount && visible; j++)
+		{
+			float distance = centerXs[i] * planes[j].x + centerYs[i] * planes[j].y + centerZs[i] * planes[j].z + planes[j].w;
+			float radius = extentXs[i] * absNormals[j].x + extentYs[i] * absNormals[j].y + extentZs[i] * absNormals[j].z;
+			visible = distance + radius >= 0;
+		}
+		if (visible) visibleMasks[i / 64] |= 1ull << (i % 64);
+	}
+}
+
 Utils::IntersectionChecker::IntersectionChecker()
 	: _intersectPlanes()
 {
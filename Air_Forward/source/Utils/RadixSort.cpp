@@ -0,0 +1,71 @@
+#include "Utils/RadixSort.h"
+#include "Utils/Log.h"
+#include <array>
+
+void Utils::RadixSort::Sort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values)
+{
+	Utils::Log::Exception("Utils::RadixSort keys and values have different size.", keys.size() != values.size());
+
+	const size_t count = keys.size();
+	if (count < 2) return;
+
+	//Count every byte in one pass
+	std::array<std::array<size_t, 256>, 8> histograms{};
+	for (const auto& key : keys)
+	{
+		for (size_t byteIndex = 0; byteIndex < 8; byteIndex++)
+		{
+			histograms[byteIndex][(key >> (byteIndex * 8)) & 0xFF]++;
+		}
+	}
+
+	_keyBuffer.resize(count);
+	_valueBuffer.resize(count);
+	uint64_t* srcKeys = keys.data();
+	uint32_t* srcValues = values.data();
+	uint64_t* dstKeys = _keyBuffer.data();
+	uint32_t* dstValues = _valueBuffer.data();
+
+	for (size_t byteIndex = 0; byteIndex < 8; byteIndex++)
+	{
+		auto& histogram = histograms[byteIndex];
+		const size_t shift = byteIndex * 8;
+
+		//Skip bytes shared by every key
+		if (histogram[(srcKeys[0] >> shift) & 0xFF] == count) continue;
+
+		std::array<size_t, 256> offsets;
+		size_t offset = 0;
+		for (size_t bucket = 0; bucket < 256; bucket++)
+		{
+			offsets[bucket] = offset;
+			offset += histogram[bucket];
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			size_t target = offsets[(srcKeys[i] >> shift) & 0xFF]++;
+			dstKeys[target] = srcKeys[i];
+			dstValues[target] = srcValues[i];
+		}
+
+		std::swap(srcKeys, dstKeys);
+		std::swap(srcValues, dstValues);
+	}
+
+	if (srcKeys != keys.data())
+	{
+		keys.swap(_keyBuffer);
+		values.swap(_valueBuffer);
+	}
+}
+
+Utils::RadixSort::RadixSort()
+	: _keyBuffer()
+	, _valueBuffer()
+{
+}
+
+Utils::RadixSort::~RadixSort()
+{
+}
\ No newline at end of file
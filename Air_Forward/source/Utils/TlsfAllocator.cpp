@@ -0,0 +1,290 @@
+#include "Utils/TlsfAllocator.h"
+#include "Utils/Log.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+	uint32_t LowestBit(uint64_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanForward64(&index, value);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+	}
+
+	uint32_t HighestBit(uint64_t value)
+	{
+#ifdef _MSC_VER
+		unsigned long index = 0;
+		_BitScanReverse64(&index, value);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(63 - __builtin_clzll(value));
+#endif
+	}
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+Utils::TlsfAllocator::TlsfAllocator(uint64_t size)
+	: _blocks()
+	, _unusedBlocks()
+	, _flBitmap(0)
+	, _slBitmaps()
+	, _freeBlocks()
+	, _allocatedBlocks()
+	, _size(size & ~(GRANULARITY - 1))
+	, _allocatedSize(0)
+{
+	for (auto& freeBlocks : _freeBlocks)
+	{
+		freeBlocks.fill(NULL_BLOCK);
+	}
+	_slBitmaps.fill(0);
+
+	if (_size > 0)
+	{
+		_Insert(_NewBlock(0, _size));
+	}
+}
+
+Utils::TlsfAllocator::~TlsfAllocator()
+{
+}
+
+bool Utils::TlsfAllocator::Allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+{
+	size = AlignUp(std::max<uint64_t>(size, 1), GRANULARITY);
+	alignment = std::max(alignment, GRANULARITY);
+
+	//Offsets are multiples of the granularity, so a larger alignment needs at most this much padding
+	uint32_t blockIndex = _FindFree(size + alignment - GRANULARITY);
+	if (blockIndex == NULL_BLOCK) blockIndex = _FindFit(size, alignment);
+	if (blockIndex == NULL_BLOCK) return false;
+	_Remove(blockIndex);
+
+	//Split the alignment padding off the front
+	uint64_t padding = AlignUp(_blocks[blockIndex].offset, alignment) - _blocks[blockIndex].offset;
+	if (padding > 0)
+	{
+		uint32_t frontIndex = _NewBlock(_blocks[blockIndex].offset, padding);
+		_blocks[frontIndex].prevPhysical = _blocks[blockIndex].prevPhysical;
+		_blocks[frontIndex].nextPhysical = blockIndex;
+		if (_blocks[blockIndex].prevPhysical != NULL_BLOCK) _blocks[_blocks[blockIndex].prevPhysical].nextPhysical = frontIndex;
+		_blocks[blockIndex].prevPhysical = frontIndex;
+		_blocks[blockIndex].offset += padding;
+		_blocks[blockIndex].size -= padding;
+		_Insert(frontIndex);
+	}
+
+	//Split the remainder off the back
+	if (_blocks[blockIndex].size > size)
+	{
+		uint32_t backIndex = _NewBlock(_blocks[blockIndex].offset + size, _blocks[blockIndex].size - size);
+		_blocks[backIndex].prevPhysical = blockIndex;
+		_blocks[backIndex].nextPhysical = _blocks[blockIndex].nextPhysical;
+		if (_blocks[blockIndex].nextPhysical != NULL_BLOCK) _blocks[_blocks[blockIndex].nextPhysical].prevPhysical = backIndex;
+		_blocks[blockIndex].nextPhysical = backIndex;
+		_blocks[blockIndex].size = size;
+		_Insert(backIndex);
+	}
+
+	_blocks[blockIndex].free = false;
+	_allocatedBlocks.emplace(_blocks[blockIndex].offset, blockIndex);
+	_allocatedSize += size;
+	offset = _blocks[blockIndex].offset;
+	return true;
+}
+
+void Utils::TlsfAllocator::Free(uint64_t offset)
+{
+	auto iterator = _allocatedBlocks.find(offset);
+	if (iterator == _allocatedBlocks.end())
+	{
+		Utils::Log::Exception("Utils::TlsfAllocator free an offset that is not allocated.");
+		return;
+	}
+	uint32_t blockIndex = iterator->second;
+	_allocatedBlocks.erase(iterator);
+	_allocatedSize -= _blocks[blockIndex].size;
+	_blocks[blockIndex].free = true;
+
+	//Merge with the previous neighbour
+	uint32_t prevIndex = _blocks[blockIndex].prevPhysical;
+	if (prevIndex != NULL_BLOCK && _blocks[prevIndex].free)
+	{
+		_Remove(prevIndex);
+		_blocks[prevIndex].size += _blocks[blockIndex].size;
+		_blocks[prevIndex].nextPhysical = _blocks[blockIndex].nextPhysical;
+		if (_blocks[blockIndex].nextPhysical != NULL_BLOCK) _blocks[_blocks[blockIndex].nextPhysical].prevPhysical = prevIndex;
+		_ReleaseBlock(blockIndex);
+		blockIndex = prevIndex;
+	}
+
+	//Merge with the next neighbour
+	uint32_t nextIndex = _blocks[blockIndex].nextPhysical;
+	if (nextIndex != NULL_BLOCK && _blocks[nextIndex].free)
+	{
+		_Remove(nextIndex);
+		_blocks[blockIndex].size += _blocks[nextIndex].size;
+		_blocks[blockIndex].nextPhysical = _blocks[nextIndex].nextPhysical;
+		if (_blocks[nextIndex].nextPhysical != NULL_BLOCK) _blocks[_blocks[nextIndex].nextPhysical].prevPhysical = blockIndex;
+		_ReleaseBlock(nextIndex);
+	}
+
+	_Insert(blockIndex);
+}
+
+uint64_t Utils::TlsfAllocator::Size()
+{
+	return _size;
+}
+
+uint64_t Utils::TlsfAllocator::AllocatedSize()
+{
+	return _allocatedSize;
+}
+
+uint32_t Utils::TlsfAllocator::AllocationCount()
+{
+	return static_cast<uint32_t>(_allocatedBlocks.size());
+}
+
+uint64_t Utils::TlsfAllocator::LargestFreeSize()
+{
+	if (_flBitmap == 0) return 0;
+
+	//Only the highest non empty list can hold the largest block
+	uint32_t fl = HighestBit(_flBitmap);
+	uint32_t sl = HighestBit(_slBitmaps[fl]);
+	uint64_t largestSize = 0;
+	for (uint32_t blockIndex = _freeBlocks[fl][sl]; blockIndex != NULL_BLOCK; blockIndex = _blocks[blockIndex].nextFree)
+	{
+		largestSize = std::max(largestSize, _blocks[blockIndex].size);
+	}
+	return largestSize;
+}
+
+void Utils::TlsfAllocator::_Mapping(uint64_t size, uint32_t& fl, uint32_t& sl)
+{
+	if (size < SMALL_BLOCK_SIZE)
+	{
+		fl = 0;
+		sl = static_cast<uint32_t>(size / (SMALL_BLOCK_SIZE / SL_COUNT));
+	}
+	else
+	{
+		uint32_t highestBit = HighestBit(size);
+		sl = static_cast<uint32_t>(size >> (highestBit - SL_COUNT_LOG2)) ^ SL_COUNT;
+		fl = highestBit - (FL_SHIFT - 1);
+	}
+}
+
+uint32_t Utils::TlsfAllocator::_FindFree(uint64_t size)
+{
+	//Round up to the next list so every block in it is large enough
+	if (size >= SMALL_BLOCK_SIZE)
+	{
+		uint64_t round = (1ull << (HighestBit(size) - SL_COUNT_LOG2)) - 1;
+		if (size + round < size) return NULL_BLOCK;
+		size += round;
+	}
+	uint32_t fl = 0;
+	uint32_t sl = 0;
+	_Mapping(size, fl, sl);
+	if (fl >= FL_COUNT) return NULL_BLOCK;
+
+	uint32_t slMap = _slBitmaps[fl] & (~0u << sl);
+	if (slMap == 0)
+	{
+		uint64_t flMap = fl + 1 < 64 ? _flBitmap & (~0ull << (fl + 1)) : 0;
+		if (flMap == 0) return NULL_BLOCK;
+		fl = LowestBit(flMap);
+		slMap = _slBitmaps[fl];
+	}
+	sl = LowestBit(slMap);
+	return _freeBlocks[fl][sl];
+}
+
+uint32_t Utils::TlsfAllocator::_FindFit(uint64_t size, uint64_t alignment)
+{
+	//The rounded up search skips the request's own list, which may still hold a fitting block
+	uint32_t fl = 0;
+	uint32_t sl = 0;
+	_Mapping(size, fl, sl);
+	for (uint32_t blockIndex = _freeBlocks[fl][sl]; blockIndex != NULL_BLOCK; blockIndex = _blocks[blockIndex].nextFree)
+	{
+		const auto& block = _blocks[blockIndex];
+		if (AlignUp(block.offset, alignment) + size <= block.offset + block.size) return blockIndex;
+	}
+	return NULL_BLOCK;
+}
+
+void Utils::TlsfAllocator::_Insert(uint32_t blockIndex)
+{
+	uint32_t fl = 0;
+	uint32_t sl = 0;
+	_Mapping(_blocks[blockIndex].size, fl, sl);
+
+	auto& block = _blocks[blockIndex];
+	block.free = true;
+	block.prevFree = NULL_BLOCK;
+	block.nextFree = _freeBlocks[fl][sl];
+	if (block.nextFree != NULL_BLOCK) _blocks[block.nextFree].prevFree = blockIndex;
+	_freeBlocks[fl][sl] = blockIndex;
+	_flBitmap |= 1ull << fl;
+	_slBitmaps[fl] |= 1u << sl;
+}
+
+void Utils::TlsfAllocator::_Remove(uint32_t blockIndex)
+{
+	uint32_t fl = 0;
+	uint32_t sl = 0;
+	_Mapping(_blocks[blockIndex].size, fl, sl);
+
+	auto& block = _blocks[blockIndex];
+	if (block.prevFree != NULL_BLOCK) _blocks[block.prevFree].nextFree = block.nextFree;
+	if (block.nextFree != NULL_BLOCK) _blocks[block.nextFree].prevFree = block.prevFree;
+	if (_freeBlocks[fl][sl] == blockIndex)
+	{
+		_freeBlocks[fl][sl] = block.nextFree;
+		if (block.nextFree == NULL_BLOCK)
+		{
+			_slBitmaps[fl] &= ~(1u << sl);
+			if (_slBitmaps[fl] == 0) _flBitmap &= ~(1ull << fl);
+		}
+	}
+	block.prevFree = NULL_BLOCK;
+	block.nextFree = NULL_BLOCK;
+}
+
+uint32_t Utils::TlsfAllocator::_NewBlock(uint64_t offset, uint64_t size)
+{
+	uint32_t blockIndex = 0;
+	if (_unusedBlocks.empty())
+	{
+		blockIndex = static_cast<uint32_t>(_blocks.size());
+		_blocks.emplace_back();
+	}
+	else
+	{
+		blockIndex = _unusedBlocks.back();
+		_unusedBlocks.pop_back();
+	}
+	_blocks[blockIndex] = { offset, size, NULL_BLOCK, NULL_BLOCK, NULL_BLOCK, NULL_BLOCK, false };
+	return blockIndex;
+}
+
+void Utils::TlsfAllocator::_ReleaseBlock(uint32_t blockIndex)
+{
+	_unusedBlocks.emplace_back(blockIndex);
+}
\ No newline at end of file
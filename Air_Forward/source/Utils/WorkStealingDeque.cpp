@@ -0,0 +1,63 @@
+#include "Utils/WorkStealingDeque.h"
+#include "Utils/Log.h"
+
+Utils::WorkStealingDeque::WorkStealingDeque(size_t capacity)
+	: _mask(static_cast<int64_t>(capacity) - 1)
+	, _values(capacity)
+	, _top(0)
+	, _bottom(0)
+{
+	Utils::Log::Exception("Utils::WorkStealingDeque capacity must be a power of two.", capacity < 2 || (capacity & (capacity - 1)) != 0);
+}
+
+Utils::WorkStealingDeque::~WorkStealingDeque()
+{
+}
+
+bool Utils::WorkStealingDeque::Push(uint32_t value)
+{
+	int64_t bottom = _bottom.load(std::memory_order_relaxed);
+	int64_t top = _top.load(std::memory_order_acquire);
+	if (bottom - top > _mask) return false;
+
+	_values[bottom & _mask].store(value, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	_bottom.store(bottom + 1, std::memory_order_relaxed);
+	return true;
+}
+
+bool Utils::WorkStealingDeque::Pop(uint32_t& value)
+{
+	int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+	_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t top = _top.load(std::memory_order_relaxed);
+
+	if (top > bottom)
+	{
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	value = _values[bottom & _mask].load(std::memory_order_relaxed);
+	if (top == bottom)
+	{
+		//Last value, race against thieves
+		bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+bool Utils::WorkStealingDeque::Steal(uint32_t& value)
+{
+	int64_t top = _top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+	if (top >= bottom) return false;
+
+	value = _values[top & _mask].load(std::memory_order_relaxed);
+	return _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
\ No newline at end of file
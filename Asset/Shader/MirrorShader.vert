@@ -1,6 +1,7 @@
 #version 450
 #extension GL_GOOGLE_include_directive: enable
 
+#define INSTANCE_INDEX gl_InstanceIndex
 #include "Common.glsl"
 #include "Camera.glsl"
 #include "Light.glsl"
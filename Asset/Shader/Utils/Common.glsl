@@ -2,27 +2,37 @@
 #define _COMMON_GLSL_
 
 #define START_SET 7
+//Buffers in this set are bound from per frame ring buffers with dynamic offsets
+#define FRAME_DATA_SET 0
 
-layout(set = 0, binding = 0) uniform MatrixData{
+#ifndef INSTANCE_INDEX
+#define INSTANCE_INDEX 0
+#endif
+
+struct InstanceData{
     mat4 model;
+    mat4 itModel;
+};
+
+layout(set = FRAME_DATA_SET, binding = 0) readonly buffer MatrixData{
     mat4 view;
     mat4 projection;
-    mat4 itModel;
+    InstanceData instances[];
 } matrixData;
 
 vec4 PositionObjectToProjection(vec4 position)
 {
-    return matrixData.projection * matrixData.view * matrixData.model * position;
+    return matrixData.projection * matrixData.view * matrixData.instances[INSTANCE_INDEX].model * position;
 }
 
 vec4 PositionObjectToWorld(vec4 position)
 {
-    return matrixData.model * position;
+    return matrixData.instances[INSTANCE_INDEX].model * position;
 }
 
 vec3 DirectionObjectToWorld(vec3 direction)
 {
-    return normalize(mat3(matrixData.itModel) * direction);
+    return normalize(mat3(matrixData.instances[INSTANCE_INDEX].itModel) * direction);
 }
 
 vec3 NormalColorToTangent(vec4 normalColor)